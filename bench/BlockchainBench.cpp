@@ -0,0 +1,520 @@
+// bench/BlockchainBench.cpp
+// Microbenchmarks for the hot paths. Usage:
+//   blockchain_bench [--output results.json] [--quick] [--filter substring]
+#include "Block.h"
+#include "Blockchain.h"
+#include "Miner.h"
+#include "Transaction.h"
+#include "Wallet.h"
+#include "WireFormat.h"
+#include "utils/Encoding.h"
+#include "utils/Hashing.h"
+#include "utils/MerkleTree.h"
+#include "utils/Sha256.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct BenchResult {
+        std::string name;
+        std::vector<std::pair<std::string, std::string>> params;
+        unsigned long long iterations = 0;
+        double seconds = 0.0;
+        double bytesPerOp = 0.0;    // Set for throughput benchmarks
+        double customRate = 0.0;    // Rate reported by the code under test (e.g. hashes/s)
+        std::string customUnit;
+    };
+
+    struct BenchConfig {
+        double minSeconds = 0.25;
+        bool quick = false;
+        std::string filter;
+        std::string output = "blockchain_bench.json";
+    };
+
+    // Keeps results observable so the optimizer cannot drop the measured work
+    volatile std::uint64_t sink = 0;
+
+    std::string formatSize(std::size_t n) {
+        if (n >= 1000000 && n % 1000000 == 0) return std::to_string(n / 1000000) + "M";
+        if (n >= 1000 && n % 1000 == 0) return std::to_string(n / 1000) + "k";
+        return std::to_string(n);
+    }
+
+    class BenchRunner {
+    private:
+        BenchConfig config;
+        std::vector<BenchResult> results;
+
+    public:
+        explicit BenchRunner(const BenchConfig& config) : config(config) {}
+
+        const BenchConfig& getConfig() const { return config; }
+        const std::vector<BenchResult>& getResults() const { return results; }
+
+        bool enabled(const std::string& name) const {
+            return config.filter.empty() || name.find(config.filter) != std::string::npos;
+        }
+
+        // Doubles the batch size until one batch runs for at least minSeconds
+        void run(BenchResult result, const std::function<void()>& op) {
+            if (!enabled(result.name)) return;
+            op();  // Warm-up: caches, lazily built pools, key parsing
+
+            unsigned long long iterations = 1;
+            double elapsed = 0.0;
+            for (;;) {
+                auto start = std::chrono::steady_clock::now();
+                for (unsigned long long i = 0; i < iterations; ++i) op();
+                elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (elapsed >= config.minSeconds || iterations >= (1ULL << 40)) break;
+                iterations *= 2;
+            }
+            result.iterations = iterations;
+            result.seconds = elapsed;
+            record(std::move(result));
+        }
+
+        void record(BenchResult result) {
+            std::cout << result.name;
+            for (const auto& param : result.params) std::cout << " " << param.first << "=" << param.second;
+            double nsPerOp = result.iterations ? result.seconds * 1e9 / result.iterations : 0.0;
+            std::cout << ": " << nsPerOp << " ns/op";
+            if (result.bytesPerOp > 0.0) {
+                std::cout << ", " << result.bytesPerOp * result.iterations / result.seconds / 1e6 << " MB/s";
+            }
+            if (!result.customUnit.empty()) {
+                std::cout << ", " << static_cast<long long>(result.customRate) << " " << result.customUnit;
+            }
+            std::cout << std::endl;
+            results.push_back(std::move(result));
+        }
+    };
+
+    void benchSha256(BenchRunner& runner) {
+        const std::size_t sizes[] = {32, 64, 256, 1024, 16384, 1048576};
+        const Sha256::Backend backends[] = {Sha256::Backend::Scalar, Sha256::Backend::Avx2, Sha256::Backend::ShaNi};
+        Sha256::Backend original = Sha256::activeBackend();
+
+        for (Sha256::Backend backend : backends) {
+            if (!Sha256::setBackend(backend)) continue;
+            for (std::size_t size : sizes) {
+                std::vector<unsigned char> input(size, 0x5a);
+                BenchResult result;
+                result.name = "sha256";
+                result.params = {{"backend", Sha256::backendName(backend)}, {"bytes", std::to_string(size)}};
+                result.bytesPerOp = static_cast<double>(size);
+                runner.run(result, [&] {
+                    Hash256 digest = Hashing::sha256(input.data(), input.size());
+                    sink = sink + digest.bytes[0];
+                });
+            }
+
+            // Batched 64-byte messages, the shape of Merkle pair hashing
+            const std::size_t batch = 1024;
+            std::vector<unsigned char> messages(batch * 64, 0x3c);
+            std::vector<const void*> pointers(batch);
+            std::vector<std::size_t> lengths(batch, 64);
+            std::vector<Hash256> digests(batch);
+            for (std::size_t i = 0; i < batch; ++i) pointers[i] = messages.data() + i * 64;
+
+            BenchResult result;
+            result.name = "sha256_batch";
+            result.params = {{"backend", Sha256::backendName(backend)}, {"messages", std::to_string(batch)}, {"bytes", "64"}};
+            result.bytesPerOp = static_cast<double>(batch * 64);
+            runner.run(result, [&] {
+                Hashing::sha256Batch(pointers.data(), lengths.data(), batch, digests.data());
+                sink = sink + digests[0].bytes[0];
+            });
+        }
+        Sha256::setBackend(original);
+    }
+
+    void benchMerkle(BenchRunner& runner) {
+        std::vector<std::size_t> leafCounts = {1, 10, 100, 1000, 10000, 100000, 1000000};
+        if (runner.getConfig().quick) leafCounts.resize(5);
+
+        for (std::size_t count : leafCounts) {
+            std::vector<Hash256> leaves(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                std::uint64_t value = i;
+                leaves[i] = Hashing::sha256(&value, sizeof(value));
+            }
+            BenchResult result;
+            result.name = "merkle_root";
+            result.params = {{"leaves", formatSize(count)}};
+            runner.run(result, [&] {
+                Hash256 root = MerkleTree::computeMerkleRoot(leaves);
+                sink = sink + root.bytes[0];
+            });
+        }
+    }
+
+    void benchMining(BenchRunner& runner) {
+        const int maxDifficulty = runner.getConfig().quick ? 4 : 6;
+        std::vector<unsigned int> threadCounts = {1};
+        if (std::thread::hardware_concurrency() > 1) threadCounts.push_back(std::thread::hardware_concurrency());
+        Hash256 sender = Hashing::sha256(std::string("bench-sender"));
+        Hash256 receiver = Hashing::sha256(std::string("bench-receiver"));
+        std::vector<Transaction> transactions(100, Transaction(sender, receiver, COIN, 0, 1700000000, Signature{}));
+
+        for (unsigned int threads : threadCounts) {
+            for (int difficulty = 1; difficulty <= maxDifficulty; ++difficulty) {
+                BenchResult result;
+                result.name = "mine_block";
+                result.params = {{"difficulty", std::to_string(difficulty)}, {"threads", std::to_string(threads)}};
+                if (!runner.enabled(result.name)) continue;
+
+                // Distinct timestamps give independent searches; aggregate their attempts
+                unsigned long long attempts = 0;
+                unsigned long long blocks = 0;
+                double elapsed = 0.0;
+                for (long long ts = 1700000000; elapsed < runner.getConfig().minSeconds || blocks < 3; ++ts) {
+                    Block block(1, transactions, Hash256{}, ts);
+                    MiningStats stats = block.mineBlock(difficulty, threads);
+                    attempts += stats.attempts;
+                    elapsed += stats.elapsedSeconds;
+                    ++blocks;
+                }
+                result.iterations = blocks;
+                result.seconds = elapsed;
+                result.customRate = elapsed > 0.0 ? attempts / elapsed : 0.0;
+                result.customUnit = "H/s";
+                runner.record(result);
+            }
+        }
+    }
+
+    std::vector<Hash256> benchAddresses() {
+        std::vector<Hash256> addresses;
+        for (int i = 0; i < 100; ++i) {
+            addresses.push_back(Hashing::sha256("bench-address-" + std::to_string(i)));
+        }
+        return addresses;
+    }
+
+    // Builds a chain of the given length; every block moves coins between 100 addresses
+    std::unique_ptr<Blockchain> buildChain(std::size_t blocks, const std::vector<Hash256>& addresses) {
+        auto blockchain = std::make_unique<Blockchain>(addresses[0]);
+
+        // minePendingTransactions reports every block; keep the benchmark output readable
+        std::ostringstream discard;
+        std::streambuf* original = std::cout.rdbuf(discard.rdbuf());
+        for (std::size_t height = 1; height < blocks; ++height) {
+            std::vector<Transaction> batch;
+            for (std::size_t i = 0; i < 20; ++i) {
+                const Hash256& from = addresses[(height * 20 + i) % addresses.size()];
+                const Hash256& to = addresses[(height * 20 + i + 1) % addresses.size()];
+                batch.emplace_back(from, to, static_cast<Amount>(i + 1) * COIN, 1000,
+                                   static_cast<std::int64_t>(1700000000 + height), Signature{});
+            }
+            blockchain->addTransactions(batch);
+            blockchain->minePendingTransactions(addresses[height % addresses.size()]);
+            discard.str("");
+        }
+        std::cout.rdbuf(original);
+        return blockchain;
+    }
+
+    void benchChain(BenchRunner& runner) {
+        std::vector<std::size_t> lengths = {10, 100, 1000};
+        if (!runner.getConfig().quick) lengths.push_back(5000);
+
+        std::vector<Hash256> addresses = benchAddresses();
+
+        for (std::size_t length : lengths) {
+            if (!runner.enabled("balance_lookup") && !runner.enabled("chain_validation")) return;
+            std::unique_ptr<Blockchain> blockchain = buildChain(length, addresses);
+
+            std::size_t next = 0;
+            BenchResult lookup;
+            lookup.name = "balance_lookup";
+            lookup.params = {{"blocks", std::to_string(length)}};
+            runner.run(lookup, [&] {
+                sink = sink + static_cast<std::uint64_t>(blockchain->getBalanceOfAddress(addresses[next++ % addresses.size()]));
+            });
+
+            BenchResult validation;
+            validation.name = "chain_validation";
+            validation.params = {{"blocks", std::to_string(length)}, {"mode", "full"}};
+            runner.run(validation, [&] {
+                sink = sink + (blockchain->revalidateChain() ? 1 : 0);
+            });
+
+            BenchResult incremental;
+            incremental.name = "chain_validation";
+            incremental.params = {{"blocks", std::to_string(length)}, {"mode", "incremental"}};
+            runner.run(incremental, [&] {
+                sink = sink + (blockchain->isChainValid() ? 1 : 0);
+            });
+        }
+    }
+
+    // Reader threads query balances for a fixed wall time, optionally while a background
+    // Miner keeps appending blocks; reports aggregate lookups per second
+    void benchConcurrentReads(BenchRunner& runner) {
+        if (!runner.enabled("balance_lookup_concurrent")) return;
+        std::vector<unsigned int> threadCounts = {1};
+        if (std::thread::hardware_concurrency() > 1) threadCounts.push_back(std::thread::hardware_concurrency());
+
+        std::vector<Hash256> addresses = benchAddresses();
+        std::unique_ptr<Blockchain> blockchain = buildChain(100, addresses);
+
+        for (bool mining : {false, true}) {
+            for (unsigned int threads : threadCounts) {
+                Miner miner(*blockchain, addresses[1]);
+                if (mining) miner.start();
+
+                std::atomic<bool> done{false};
+                std::vector<unsigned long long> lookups(threads, 0);
+                std::vector<std::thread> readers;
+                std::size_t heightBefore = blockchain->getBlockCount();
+                auto start = std::chrono::steady_clock::now();
+                for (unsigned int t = 0; t < threads; ++t) {
+                    readers.emplace_back([&, t] {
+                        unsigned long long count = 0;
+                        std::uint64_t local = 0;
+                        while (!done.load(std::memory_order_relaxed)) {
+                            local += static_cast<std::uint64_t>(blockchain->getBalanceOfAddress(addresses[(count + t) % addresses.size()]));
+                            ++count;
+                        }
+                        lookups[t] = count;
+                        sink = sink + local;
+                    });
+                }
+                std::this_thread::sleep_for(std::chrono::duration<double>(runner.getConfig().minSeconds));
+                done = true;
+                for (auto& reader : readers) reader.join();
+                double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                miner.stop();
+
+                BenchResult result;
+                result.name = "balance_lookup_concurrent";
+                result.params = {{"threads", std::to_string(threads)}, {"mining", mining ? "on" : "off"},
+                                 {"blocks_appended", std::to_string(blockchain->getBlockCount() - heightBefore)}};
+                for (unsigned long long count : lookups) result.iterations += count;
+                result.seconds = elapsed;
+                result.customRate = elapsed > 0.0 ? result.iterations / elapsed : 0.0;
+                result.customUnit = "lookups/s";
+                runner.record(result);
+            }
+        }
+    }
+
+    // Encoding, full decoding and an in-place scan of a signed 1000-transaction block
+    void benchWire(BenchRunner& runner) {
+        std::vector<Hash256> addresses = benchAddresses();
+        Signature signature;
+        signature.fill(0x5a);
+        std::vector<Transaction> transactions;
+        for (std::size_t i = 0; i < 1000; ++i) {
+            transactions.emplace_back(addresses[i % addresses.size()], addresses[(i + 1) % addresses.size()],
+                                      static_cast<Amount>(i + 1) * COIN, 1000, 1700000000, signature);
+        }
+        Block block(1, transactions, Hash256{}, 1700000000);
+        std::vector<unsigned char> encoded = WireFormat::encode(block);
+        std::vector<unsigned char> buffer(encoded.size());
+
+        BenchResult encode;
+        encode.name = "wire_encode_block";
+        encode.params = {{"transactions", "1000"}, {"bytes", std::to_string(encoded.size())}};
+        encode.bytesPerOp = static_cast<double>(encoded.size());
+        runner.run(encode, [&] {
+            WireFormat::encode(block, buffer.data());
+            sink = sink + buffer[buffer.size() - 1];
+        });
+
+        BenchResult decode;
+        decode.name = "wire_decode_block";
+        decode.params = encode.params;
+        decode.bytesPerOp = static_cast<double>(encoded.size());
+        runner.run(decode, [&] {
+            Block decoded = WireFormat::decodeBlock(encoded.data(), encoded.size());
+            sink = sink + decoded.getTransactionCount();
+        });
+
+        BenchResult scan;
+        scan.name = "wire_scan_block";
+        scan.params = encode.params;
+        scan.bytesPerOp = static_cast<double>(encoded.size());
+        runner.run(scan, [&] {
+            BlockReader reader(encoded.data(), encoded.size());
+            TransactionView tx;
+            Amount total = 0;
+            while (reader.next(tx)) total += tx.getAmount();
+            sink = sink + static_cast<std::uint64_t>(total);
+        });
+    }
+
+    void benchEncoding(BenchRunner& runner) {
+        Hash256 hash = Hashing::sha256("encoding");
+        std::vector<unsigned char> signature(72, 0xa5);  // ECDSA DER signature size
+        std::string encoded(Encoding::base64Size(signature.size()), '\0');
+        Encoding::toBase64(signature.data(), signature.size(), &encoded[0]);
+        char buffer[128];
+        unsigned char decoded[128];
+
+        BenchResult hex;
+        hex.name = "encode_hex";
+        hex.params = {{"bytes", std::to_string(Hash256::SIZE)}};
+        hex.bytesPerOp = Hash256::SIZE;
+        runner.run(hex, [&] {
+            hash.toHex(buffer);
+            sink = sink + static_cast<unsigned char>(buffer[0]);
+        });
+
+        BenchResult base64;
+        base64.name = "encode_base64";
+        base64.params = {{"bytes", std::to_string(signature.size())}};
+        base64.bytesPerOp = static_cast<double>(signature.size());
+        runner.run(base64, [&] {
+            Encoding::toBase64(signature.data(), signature.size(), buffer);
+            sink = sink + static_cast<unsigned char>(buffer[0]);
+        });
+
+        BenchResult unbase64;
+        unbase64.name = "decode_base64";
+        unbase64.params = base64.params;
+        unbase64.bytesPerOp = static_cast<double>(signature.size());
+        runner.run(unbase64, [&] {
+            std::size_t written = 0;
+            Encoding::fromBase64(encoded.data(), encoded.size(), decoded, written);
+            sink = sink + written;
+        });
+
+        BenchResult utc;
+        utc.name = "encode_utc_time";
+        std::int64_t seconds = 1700000000;
+        runner.run(utc, [&] {
+            Encoding::formatUtcTime(seconds++, buffer);
+            sink = sink + static_cast<unsigned char>(buffer[18]);
+        });
+    }
+
+    void benchWallet(BenchRunner& runner) {
+        const KeyAlgorithm algorithms[] = {KeyAlgorithm::Rsa2048, KeyAlgorithm::Ed25519, KeyAlgorithm::Secp256k1};
+        const std::string message(Transaction::SERIALIZED_SIZE, 'm');
+
+        for (KeyAlgorithm algorithm : algorithms) {
+            std::string name = Wallet::algorithmName(algorithm);
+
+            BenchResult keygen;
+            keygen.name = "wallet_keygen";
+            keygen.params = {{"algorithm", name}};
+            runner.run(keygen, [&] {
+                EVP_PKEY* key = Wallet::generateKey(algorithm);
+                EVP_PKEY_free(key);
+            });
+
+            Wallet wallet(algorithm);
+            std::string publicKey = wallet.getPublicKey();
+            std::string signature = wallet.signMessage(message);
+
+            BenchResult sign;
+            sign.name = "wallet_sign";
+            sign.params = {{"algorithm", name}};
+            runner.run(sign, [&] {
+                sink = sink + wallet.signMessage(message).size();
+            });
+
+            BenchResult verify;
+            verify.name = "wallet_verify";
+            verify.params = {{"algorithm", name}};
+            runner.run(verify, [&] {
+                sink = sink + (Wallet::verifySignature(publicKey, message, signature) ? 1 : 0);
+            });
+        }
+    }
+
+    std::string jsonEscape(const std::string& value) {
+        std::string out;
+        for (char c : value) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+    void writeJson(const std::string& path, const std::vector<BenchResult>& results) {
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("blockchain_bench: cannot write " + path);
+        }
+
+        auto now = std::chrono::system_clock::now();
+        long long epoch = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+
+        out << "{\n";
+        out << "  \"context\": {\n";
+        out << "    \"timestamp\": " << epoch << ",\n";
+        out << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+        out << "    \"sha256_backend\": \"" << Sha256::backendName(Sha256::activeBackend()) << "\"\n";
+        out << "  },\n";
+        out << "  \"benchmarks\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            double nsPerOp = r.iterations ? r.seconds * 1e9 / r.iterations : 0.0;
+            out << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"params\": {";
+            for (std::size_t p = 0; p < r.params.size(); ++p) {
+                out << (p ? ", " : "") << "\"" << jsonEscape(r.params[p].first) << "\": \""
+                    << jsonEscape(r.params[p].second) << "\"";
+            }
+            out << "}, \"iterations\": " << r.iterations
+                << ", \"seconds\": " << r.seconds
+                << ", \"ns_per_op\": " << nsPerOp
+                << ", \"ops_per_second\": " << (r.seconds > 0.0 ? r.iterations / r.seconds : 0.0);
+            if (r.bytesPerOp > 0.0) {
+                out << ", \"bytes_per_second\": " << r.bytesPerOp * r.iterations / r.seconds;
+            }
+            if (!r.customUnit.empty()) {
+                out << ", \"rate\": " << r.customRate << ", \"rate_unit\": \"" << jsonEscape(r.customUnit) << "\"";
+            }
+            out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n";
+        out << "}\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--output" && i + 1 < argc) {
+            config.output = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            config.filter = argv[++i];
+        } else if (arg == "--quick") {
+            config.quick = true;
+            config.minSeconds = 0.05;
+        } else {
+            std::cerr << "usage: blockchain_bench [--output results.json] [--quick] [--filter substring]\n";
+            return 2;
+        }
+    }
+
+    BenchRunner runner(config);
+    benchSha256(runner);
+    benchMerkle(runner);
+    benchMining(runner);
+    benchChain(runner);
+    benchConcurrentReads(runner);
+    benchWire(runner);
+    benchEncoding(runner);
+    benchWallet(runner);
+
+    writeJson(config.output, runner.getResults());
+    std::cout << "Wrote " << runner.getResults().size() << " results to " << config.output << std::endl;
+    return 0;
+}
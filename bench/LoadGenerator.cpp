@@ -0,0 +1,278 @@
+// bench/LoadGenerator.cpp
+// End-to-end load: seeded wallets sign transactions at a target rate, the chain admits them
+// with signature checks, a block is mined every interval, and the chain is revalidated at
+// the end. Usage:
+//   load_gen [--seed 1] [--wallets 1000] [--tps 2000] [--duration 10] [--block-interval 1000]
+//            [--difficulty 2] [--mining-threads 1] [--validation-threads 0] [--signers 1]
+//            [--max-block-transactions 5000] [--output load_gen.json]
+#include "Block.h"
+#include "Blockchain.h"
+#include "Transaction.h"
+#include "Wallet.h"
+#include "utils/Hashing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct LoadConfig {
+        std::uint64_t seed = 1;
+        std::size_t wallets = 1000;
+        double tps = 2000.0;              // Offered load; 0 submits as fast as the signers can
+        double duration = 10.0;           // Seconds of offered load; mining then drains the mempool
+        unsigned int blockInterval = 1000;  // Milliseconds between blocks
+        int difficulty = 2;
+        unsigned int miningThreads = 1;
+        unsigned int validationThreads = 0;
+        unsigned int signers = 1;
+        std::size_t maxBlockTransactions = 5000;
+        std::string output = "load_gen.json";
+    };
+
+    struct LoadReport {
+        std::uint64_t generated = 0;
+        std::uint64_t admitted = 0;
+        std::uint64_t confirmed = 0;
+        std::size_t blocks = 0;
+        double offeredSeconds = 0.0;
+        double confirmSeconds = 0.0;    // Start until the last transaction was confirmed
+        double validationSeconds = 0.0;
+        bool chainValid = false;
+        std::vector<double> latencies;  // Seconds from submission to confirmation
+        std::size_t peakRssBytes = 0;
+        Hash256 fingerprint;            // XOR of every generated transaction id
+    };
+
+    // splitmix64: transaction k's parameters depend only on (seed, k), never on thread timing
+    std::uint64_t mix(std::uint64_t value) {
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+    std::size_t peakRss() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+        return static_cast<std::size_t>(counters.PeakWorkingSetSize);
+#else
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return static_cast<std::size_t>(usage.ru_maxrss);          // bytes
+#else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;   // kilobytes
+#endif
+#endif
+    }
+
+    double percentile(std::vector<double> values, double fraction) {
+        if (values.empty()) return 0.0;
+        std::sort(values.begin(), values.end());
+        return values[static_cast<std::size_t>(fraction * (values.size() - 1) + 0.5)];
+    }
+
+    LoadReport run(const LoadConfig& config) {
+        LoadReport report;
+
+        // Wallets, and therefore addresses, signatures and ids, follow from the seed
+        std::vector<std::unique_ptr<Wallet>> wallets;
+        Blockchain chain(Hashing::sha256("load-gen-genesis-" + std::to_string(config.seed)));
+        for (std::size_t i = 0; i < config.wallets; ++i) {
+            wallets.push_back(std::make_unique<Wallet>(
+                Hashing::sha256("load-gen-wallet-" + std::to_string(config.seed) + "-" + std::to_string(i))));
+            chain.registerPublicKey(wallets.back()->getPublicKey());
+        }
+        Hash256 minerAddress = Hashing::sha256("load-gen-miner-" + std::to_string(config.seed));
+
+        chain.setDifficulty(config.difficulty);
+        chain.setMiningThreads(config.miningThreads);
+        chain.setValidationThreads(config.validationThreads);
+        chain.setSignatureVerification(true);
+        MempoolOptions mempoolOptions;
+        mempoolOptions.maxBlockTransactions = config.maxBlockTransactions;
+        mempoolOptions.maxBlockBytes = config.maxBlockTransactions * Transaction::SERIALIZED_SIZE * 2;
+        chain.setMempoolOptions(mempoolOptions);
+
+        const std::uint64_t total = config.tps > 0.0 ? static_cast<std::uint64_t>(config.tps * config.duration) : 0;
+        std::mutex submittedMutex;
+        std::unordered_map<Hash256, Clock::time_point> submitted;
+        std::atomic<std::uint64_t> generated{0};
+        std::atomic<std::uint64_t> admitted{0};
+        std::atomic<bool> producing{true};
+        Clock::time_point start = Clock::now();
+
+        // Signer k takes transactions k, k + signers, ...; each is sent at its scheduled
+        // time (open loop), or back to back when tps is 0
+        std::vector<std::thread> signers;
+        std::vector<Hash256> fingerprints(config.signers);
+        for (unsigned int s = 0; s < config.signers; ++s) {
+            signers.emplace_back([&, s] {
+                for (std::uint64_t k = s;; k += config.signers) {
+                    if (config.tps > 0.0) {
+                        if (k >= total) break;
+                        std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(
+                                                                  std::chrono::duration<double>(k / config.tps)));
+                    } else if (std::chrono::duration<double>(Clock::now() - start).count() >= config.duration) {
+                        break;
+                    }
+
+                    std::uint64_t r = mix(config.seed ^ mix(k));
+                    std::size_t from = static_cast<std::size_t>(r % config.wallets);
+                    std::size_t to = static_cast<std::size_t>((from + 1 + (r >> 20) % (config.wallets - 1)) % config.wallets);
+                    Transaction tx(wallets[from]->getAddress(), wallets[to]->getAddress(),
+                                   static_cast<Amount>(1 + (r >> 40) % 1000000), static_cast<Amount>(1000 + k % 1000),
+                                   static_cast<std::int64_t>(1700000000 + k / 1000), Signature{});
+                    tx.signTransaction(*wallets[from]);
+
+                    Hash256 id = tx.getId();
+                    for (std::size_t b = 0; b < Hash256::SIZE; ++b) fingerprints[s].bytes[b] ^= id.bytes[b];
+                    ++generated;
+                    {
+                        std::lock_guard<std::mutex> lock(submittedMutex);
+                        submitted.emplace(id, Clock::now());
+                    }
+                    if (chain.addTransaction(tx)) ++admitted;
+                }
+            });
+        }
+
+        // Miner: one block per interval; once the signers stop it keeps going until the mempool is empty
+        std::thread miner([&] {
+            for (std::size_t tick = 1;; ++tick) {
+                std::this_thread::sleep_until(start + std::chrono::milliseconds(config.blockInterval) * tick);
+                bool draining = !producing.load();
+                std::vector<Transaction> transactions = chain.selectBlockTransactions(minerAddress);
+                if (transactions.size() <= 1) {
+                    if (draining) return;
+                    continue;  // Only the reward: wait for load
+                }
+                Block block = chain.createBlockTemplate(transactions);
+                block.mineBlock(config.difficulty, config.miningThreads);
+                if (!chain.submitBlock(block)) continue;
+
+                Clock::time_point now = Clock::now();
+                std::lock_guard<std::mutex> lock(submittedMutex);
+                for (const auto& tx : transactions) {
+                    auto it = submitted.find(tx.getId());
+                    if (it == submitted.end()) continue;  // The reward
+                    report.latencies.push_back(std::chrono::duration<double>(now - it->second).count());
+                    submitted.erase(it);
+                }
+                report.confirmSeconds = std::chrono::duration<double>(now - start).count();
+                ++report.blocks;
+            }
+        });
+
+        for (auto& signer : signers) signer.join();
+        report.offeredSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        producing = false;
+        miner.join();
+
+        report.generated = generated.load();
+        report.admitted = admitted.load();
+        report.confirmed = report.latencies.size();
+        for (const auto& part : fingerprints) {
+            for (std::size_t b = 0; b < Hash256::SIZE; ++b) report.fingerprint.bytes[b] ^= part.bytes[b];
+        }
+
+        Clock::time_point validationStart = Clock::now();
+        report.chainValid = chain.revalidateChain();
+        report.validationSeconds = std::chrono::duration<double>(Clock::now() - validationStart).count();
+        report.peakRssBytes = peakRss();
+        return report;
+    }
+
+    void printReport(const LoadConfig& config, const LoadReport& r) {
+        double sustained = r.confirmSeconds > 0.0 ? r.confirmed / r.confirmSeconds : 0.0;
+        std::cout << "seed " << config.seed << ", " << config.wallets << " wallets, workload " << r.fingerprint.toHex().substr(0, 16) << "\n"
+                  << "  generated " << r.generated << " in " << r.offeredSeconds << " s (" << r.generated / r.offeredSeconds
+                  << " tx/s offered), admitted " << r.admitted << "\n"
+                  << "  confirmed " << r.confirmed << " in " << r.blocks << " blocks, sustained " << sustained << " tx/s\n"
+                  << "  confirmation latency ms  p50 " << percentile(r.latencies, 0.5) * 1e3
+                  << "  p99 " << percentile(r.latencies, 0.99) * 1e3 << "  max " << percentile(r.latencies, 1.0) * 1e3 << "\n"
+                  << "  validation " << r.validationSeconds << " s (" << (r.chainValid ? "valid" : "INVALID") << ")"
+                  << ", peak RSS " << r.peakRssBytes / (1024.0 * 1024.0) << " MiB" << std::endl;
+    }
+
+    void writeJson(const std::string& path, const LoadConfig& config, const LoadReport& r) {
+        std::ofstream out(path);
+        if (!out) throw std::runtime_error("cannot write " + path);
+        out << "{\n"
+            << "  \"config\": {\"seed\": " << config.seed << ", \"wallets\": " << config.wallets
+            << ", \"tps\": " << config.tps << ", \"duration\": " << config.duration
+            << ", \"block_interval_ms\": " << config.blockInterval << ", \"difficulty\": " << config.difficulty
+            << ", \"mining_threads\": " << config.miningThreads << ", \"validation_threads\": " << config.validationThreads
+            << ", \"signers\": " << config.signers << ", \"max_block_transactions\": " << config.maxBlockTransactions << "},\n"
+            << "  \"workload\": \"" << r.fingerprint.toHex() << "\",\n"
+            << "  \"generated\": " << r.generated << ", \"admitted\": " << r.admitted << ", \"confirmed\": " << r.confirmed
+            << ", \"blocks\": " << r.blocks << ",\n"
+            << "  \"offered_tps\": " << (r.offeredSeconds > 0.0 ? r.generated / r.offeredSeconds : 0.0)
+            << ", \"sustained_tps\": " << (r.confirmSeconds > 0.0 ? r.confirmed / r.confirmSeconds : 0.0) << ",\n"
+            << "  \"latency_p50_ms\": " << percentile(r.latencies, 0.5) * 1e3
+            << ", \"latency_p99_ms\": " << percentile(r.latencies, 0.99) * 1e3
+            << ", \"latency_max_ms\": " << percentile(r.latencies, 1.0) * 1e3 << ",\n"
+            << "  \"validation_seconds\": " << r.validationSeconds << ", \"chain_valid\": " << (r.chainValid ? "true" : "false")
+            << ", \"peak_rss_bytes\": " << r.peakRssBytes << "\n"
+            << "}\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    LoadConfig config;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) throw std::invalid_argument(arg);
+            std::string value = argv[++i];
+            if (arg == "--seed") config.seed = std::stoull(value);
+            else if (arg == "--wallets") config.wallets = std::stoul(value);
+            else if (arg == "--tps") config.tps = std::stod(value);
+            else if (arg == "--duration") config.duration = std::stod(value);
+            else if (arg == "--block-interval") config.blockInterval = static_cast<unsigned int>(std::stoul(value));
+            else if (arg == "--difficulty") config.difficulty = std::stoi(value);
+            else if (arg == "--mining-threads") config.miningThreads = static_cast<unsigned int>(std::stoul(value));
+            else if (arg == "--validation-threads") config.validationThreads = static_cast<unsigned int>(std::stoul(value));
+            else if (arg == "--signers") config.signers = static_cast<unsigned int>(std::stoul(value));
+            else if (arg == "--max-block-transactions") config.maxBlockTransactions = std::stoul(value);
+            else if (arg == "--output") config.output = value;
+            else throw std::invalid_argument(arg);
+        }
+        if (config.wallets < 2 || config.signers == 0 || config.blockInterval == 0 || config.tps < 0.0) {
+            throw std::invalid_argument("parameters");
+        }
+    } catch (const std::exception&) {
+        std::cerr << "usage: load_gen [--seed 1] [--wallets 1000] [--tps 2000] [--duration 10] [--block-interval 1000]\n"
+                     "                [--difficulty 2] [--mining-threads 1] [--validation-threads 0] [--signers 1]\n"
+                     "                [--max-block-transactions 5000] [--output load_gen.json]\n";
+        return 2;
+    }
+
+    LoadReport report = run(config);
+    printReport(config, report);
+    writeJson(config.output, config, report);
+    std::cout << "Wrote " << config.output << std::endl;
+    return report.chainValid ? 0 : 1;
+}
@@ -0,0 +1,276 @@
+// bench/RelaySimulation.cpp
+// Runs N nodes on loopback and measures block propagation latency and relay bandwidth.
+// Usage:
+//   relay_sim [--nodes 8] [--peers 2] [--blocks 20] [--transactions 200] [--withheld 0.05]
+//             [--mode compact|full|both] [--seed 1] [--output relay_sim.json]
+#include "Block.h"
+#include "Blockchain.h"
+#include "WireFormat.h"
+#include "net/Node.h"
+#include "utils/Hashing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct SimConfig {
+        std::size_t nodes = 8;
+        std::size_t peers = 2;          // Outbound connections per node: to the next `peers` nodes in a ring
+        std::size_t blocks = 20;
+        std::size_t transactions = 200; // Per block
+        double withheld = 0.05;         // Share of each block's transactions only the miner has seen
+        std::string mode = "both";
+        unsigned int seed = 1;
+        std::string output = "relay_sim.json";
+    };
+
+    struct SimResult {
+        std::string mode;
+        std::size_t blocks = 0;
+        std::vector<double> latencies;   // Seconds from announcement to arrival, per block and receiving node
+        std::vector<double> fullSpread;  // Seconds until the last node had the block, per block
+        std::uint64_t blockBytes = 0;    // Block relay traffic summed over all nodes
+        std::uint64_t transactionBytes = 0;
+        std::uint64_t encodedBlockBytes = 0;  // Size of the blocks themselves in the wire format
+        NodeStats totals;
+    };
+
+    double percentile(std::vector<double> values, double fraction) {
+        if (values.empty()) return 0.0;
+        std::sort(values.begin(), values.end());
+        std::size_t index = static_cast<std::size_t>(fraction * (values.size() - 1) + 0.5);
+        return values[index];
+    }
+
+    double mean(const std::vector<double>& values) {
+        if (values.empty()) return 0.0;
+        double sum = 0.0;
+        for (double value : values) sum += value;
+        return sum / values.size();
+    }
+
+    bool waitFor(const std::function<bool()>& done, std::chrono::seconds timeout) {
+        auto deadline = Clock::now() + timeout;
+        while (!done()) {
+            if (Clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        return true;
+    }
+
+    SimResult runSimulation(const SimConfig& config, bool compact) {
+        Hash256 genesisAddress = Hashing::sha256(std::string("relay-sim-genesis"));
+        std::vector<std::unique_ptr<Blockchain>> chains;
+        std::vector<std::unique_ptr<Node>> nodes;
+        NodeOptions options;
+        options.compactBlocks = compact;
+
+        // Arrival times per block hash and node, filled from the nodes' reader threads
+        std::mutex arrivalsMutex;
+        std::unordered_map<Hash256, std::vector<Clock::time_point>> arrivals;
+        std::unordered_map<Hash256, std::size_t> arrivalCounts;
+
+        for (std::size_t i = 0; i < config.nodes; ++i) {
+            chains.push_back(std::make_unique<Blockchain>(genesisAddress));
+            nodes.push_back(std::make_unique<Node>(*chains.back(), options));
+            nodes.back()->setBlockHandler([&, i](const Block& block) {
+                Clock::time_point now = Clock::now();
+                std::lock_guard<std::mutex> lock(arrivalsMutex);
+                auto& times = arrivals[block.getHash()];
+                times.resize(config.nodes);
+                times[i] = now;
+                ++arrivalCounts[block.getHash()];
+            });
+        }
+        for (std::size_t i = 0; i < config.nodes; ++i) {
+            for (std::size_t k = 1; k <= config.peers && k < config.nodes; ++k) {
+                std::size_t target = (i + k) % config.nodes;
+                // Skip pairs the other side already dialled (dense rings)
+                if ((i + config.nodes - target) % config.nodes <= config.peers) continue;
+                nodes[i]->connect(nodes[target]->getPort());
+            }
+        }
+        waitFor([&] {
+            for (const auto& node : nodes) if (node->getPeerCount() == 0) return false;
+            return true;
+        }, std::chrono::seconds(5));
+
+        std::mt19937 rng(config.seed);
+        std::vector<Hash256> senders;
+        for (int i = 0; i < 64; ++i) senders.push_back(Hashing::sha256("relay-sim-sender-" + std::to_string(i)));
+
+        SimResult result;
+        result.mode = compact ? "compact" : "full";
+        std::uint64_t sequence = 0;
+        for (std::size_t round = 0; round < config.blocks; ++round) {
+            std::size_t miner = round % config.nodes;
+
+            // Signature bytes are filler: verification is off, but relay carries their real size
+            Signature signature;
+            for (auto& byte : signature) byte = static_cast<unsigned char>(rng());
+            std::size_t relayed = 0;
+            for (std::size_t t = 0; t < config.transactions; ++t, ++sequence) {
+                Transaction tx(senders[sequence % senders.size()], senders[(sequence + 1) % senders.size()],
+                               static_cast<Amount>(1 + sequence % 1000) * COIN, 1000,
+                               static_cast<std::int64_t>(1700000000 + sequence), signature);
+                if (std::uniform_real_distribution<double>(0.0, 1.0)(rng) < config.withheld) {
+                    chains[miner]->addTransaction(tx);
+                } else {
+                    nodes[rng() % config.nodes]->submitTransaction(tx);
+                    ++relayed;
+                }
+            }
+            // Let the transaction flood settle so block relay is measured on its own
+            waitFor([&] {
+                for (const auto& chain : chains) if (chain->getMempool()->size() < relayed) return false;
+                return true;
+            }, std::chrono::seconds(10));
+
+            std::vector<Transaction> transactions = chains[miner]->selectBlockTransactions(senders[miner % senders.size()]);
+            Block block = chains[miner]->createBlockTemplate(transactions);
+            block.mineBlock(chains[miner]->getDifficulty());
+            result.encodedBlockBytes += WireFormat::encode(block).size();
+
+            std::uint64_t blockBytesBefore = 0;
+            for (const auto& node : nodes) blockBytesBefore += node->getStats().blockBytesSent;
+
+            Clock::time_point announced = Clock::now();
+            if (!nodes[miner]->submitBlock(block)) throw std::runtime_error("relay_sim: miner rejected its own block");
+            // Handlers run just after each node appends, so wait on them rather than on chain heights
+            if (!waitFor([&] {
+                    std::lock_guard<std::mutex> lock(arrivalsMutex);
+                    return arrivalCounts[block.getHash()] == config.nodes - 1;
+                }, std::chrono::seconds(30))) {
+                throw std::runtime_error("relay_sim: block " + std::to_string(block.getIndex()) + " did not reach every node");
+            }
+
+            std::lock_guard<std::mutex> lock(arrivalsMutex);
+            const auto& times = arrivals[block.getHash()];
+            double slowest = 0.0;
+            for (std::size_t i = 0; i < config.nodes; ++i) {
+                if (i == miner) continue;
+                double seconds = std::chrono::duration<double>(times[i] - announced).count();
+                result.latencies.push_back(seconds);
+                slowest = std::max(slowest, seconds);
+            }
+            result.fullSpread.push_back(slowest);
+            ++result.blocks;
+
+            std::uint64_t blockBytesAfter = 0;
+            for (const auto& node : nodes) blockBytesAfter += node->getStats().blockBytesSent;
+            result.blockBytes += blockBytesAfter - blockBytesBefore;
+        }
+
+        for (const auto& node : nodes) {
+            NodeStats stats = node->getStats();
+            result.totals.bytesSent += stats.bytesSent;
+            result.totals.blocksConnected += stats.blocksConnected;
+            result.totals.compactBlocksReconstructed += stats.compactBlocksReconstructed;
+            result.totals.transactionsRequested += stats.transactionsRequested;
+            result.totals.fullBlockFallbacks += stats.fullBlockFallbacks;
+            result.totals.requestsAbandoned += stats.requestsAbandoned;
+            result.transactionBytes += stats.transactionBytesSent;
+        }
+        for (auto& node : nodes) node->stop();
+        return result;
+    }
+
+    void printResult(const SimConfig& config, const SimResult& r) {
+        double blocks = r.blocks ? static_cast<double>(r.blocks) : 1.0;
+        std::cout << r.mode << ": " << r.blocks << " blocks, " << config.nodes << " nodes\n"
+                  << "  latency ms   mean " << mean(r.latencies) * 1e3 << "  p50 " << percentile(r.latencies, 0.5) * 1e3
+                  << "  p95 " << percentile(r.latencies, 0.95) * 1e3 << "  all nodes " << mean(r.fullSpread) * 1e3 << "\n"
+                  << "  block bytes  " << r.blockBytes / blocks << " per block (block itself " << r.encodedBlockBytes / blocks
+                  << "), tx flood " << r.transactionBytes / blocks << " per block\n"
+                  << "  reconstructed " << r.totals.compactBlocksReconstructed << " of " << r.totals.blocksConnected
+                  << ", transactions fetched " << r.totals.transactionsRequested
+                  << ", full-block fallbacks " << r.totals.fullBlockFallbacks
+                  << ", abandoned requests " << r.totals.requestsAbandoned << std::endl;
+    }
+
+    void writeJson(const std::string& path, const SimConfig& config, const std::vector<SimResult>& results) {
+        std::ofstream out(path);
+        if (!out) throw std::runtime_error("cannot write " + path);
+        out << "{\n  \"nodes\": " << config.nodes << ", \"peers\": " << config.peers
+            << ", \"transactions_per_block\": " << config.transactions << ", \"withheld\": " << config.withheld
+            << ",\n  \"results\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const SimResult& r = results[i];
+            double blocks = r.blocks ? static_cast<double>(r.blocks) : 1.0;
+            out << "    {\"mode\": \"" << r.mode << "\", \"blocks\": " << r.blocks
+                << ", \"latency_mean_ms\": " << mean(r.latencies) * 1e3
+                << ", \"latency_p50_ms\": " << percentile(r.latencies, 0.5) * 1e3
+                << ", \"latency_p95_ms\": " << percentile(r.latencies, 0.95) * 1e3
+                << ", \"all_nodes_mean_ms\": " << mean(r.fullSpread) * 1e3
+                << ", \"block_relay_bytes_per_block\": " << r.blockBytes / blocks
+                << ", \"encoded_block_bytes\": " << r.encodedBlockBytes / blocks
+                << ", \"transaction_relay_bytes_per_block\": " << r.transactionBytes / blocks
+                << ", \"reconstructed\": " << r.totals.compactBlocksReconstructed
+                << ", \"transactions_fetched\": " << r.totals.transactionsRequested
+                << ", \"full_block_fallbacks\": " << r.totals.fullBlockFallbacks
+                << ", \"requests_abandoned\": " << r.totals.requestsAbandoned << "}"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    SimConfig config;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--nodes" && hasValue) {
+                config.nodes = std::stoul(argv[++i]);
+            } else if (arg == "--peers" && hasValue) {
+                config.peers = std::stoul(argv[++i]);
+            } else if (arg == "--blocks" && hasValue) {
+                config.blocks = std::stoul(argv[++i]);
+            } else if (arg == "--transactions" && hasValue) {
+                config.transactions = std::stoul(argv[++i]);
+            } else if (arg == "--withheld" && hasValue) {
+                config.withheld = std::stod(argv[++i]);
+            } else if (arg == "--mode" && hasValue) {
+                config.mode = argv[++i];
+            } else if (arg == "--seed" && hasValue) {
+                config.seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else if (arg == "--output" && hasValue) {
+                config.output = argv[++i];
+            } else {
+                throw std::invalid_argument(arg);
+            }
+        }
+        if (config.nodes < 2 || (config.mode != "compact" && config.mode != "full" && config.mode != "both")) {
+            throw std::invalid_argument("--nodes/--mode");
+        }
+    } catch (const std::exception&) {
+        std::cerr << "usage: relay_sim [--nodes 8] [--peers 2] [--blocks 20] [--transactions 200] [--withheld 0.05]\n"
+                     "                 [--mode compact|full|both] [--seed 1] [--output relay_sim.json]\n";
+        return 2;
+    }
+
+    std::vector<SimResult> results;
+    for (bool compact : {true, false}) {
+        if (config.mode == (compact ? "full" : "compact")) continue;
+        results.push_back(runSimulation(config, compact));
+        printResult(config, results.back());
+    }
+    writeJson(config.output, config, results);
+    std::cout << "Wrote " << results.size() << " results to " << config.output << std::endl;
+    return 0;
+}
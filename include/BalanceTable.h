@@ -0,0 +1,45 @@
+// include/BalanceTable.h
+#ifndef BALANCE_TABLE_H
+#define BALANCE_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include "TransactionColumns.h"
+#include "utils/Amount.h"
+#include "utils/Hash256.h"
+
+// Address -> balance map with structural sharing. Addresses route through a fixed
+// two-level trie (256 x 256 leaves) keyed on their last two bytes. Copying a table
+// copies only the root; a write then copies the inner node and leaf on its path if
+// another table still shares them, and updates in place otherwise. Publishing a block
+// therefore costs roughly one small leaf per touched address, and older copies stay
+// immutable for readers. Copies may be read concurrently; a single table is not
+// safe to write while it is read.
+class BalanceTable {
+private:
+    using Leaf = std::unordered_map<Hash256, Amount>;
+    struct Inner {
+        std::array<std::shared_ptr<Leaf>, 256> leaves;
+    };
+
+    std::array<std::shared_ptr<Inner>, 256> root;
+
+    Leaf& writableLeaf(const Hash256& address);
+
+public:
+    Amount get(const Hash256& address) const;  // 0 for unknown addresses
+    void add(const Hash256& address, Amount delta);
+
+    // Debits senders amount + fee and credits receivers amount; rewards have no sender.
+    // Returns false if a balance would overflow, leaving the table partly updated, so
+    // apply to a copy when the block is untrusted.
+    bool applyBlock(const TransactionColumns& transactions);
+
+    std::size_t size() const;  // Addresses ever touched, including those back at zero
+    void forEach(const std::function<void(const Hash256&, Amount)>& visit) const;
+};
+
+#endif
@@ -2,32 +2,86 @@
 #ifndef BLOCK_H
 #define BLOCK_H
 
+#include <atomic>
+#include <memory_resource>
 #include <string>
 #include <vector>
+#include "BlockHeader.h"
 #include "Transaction.h"
+#include "TransactionColumns.h"
+#include "utils/Hash256.h"
+#include "utils/MerkleTree.h"
+
+// Outcome of a proof-of-work search, reported per worker thread
+struct MiningStats {
+    unsigned int threads = 0;
+    unsigned long long attempts = 0;
+    double elapsedSeconds = 0.0;
+    std::vector<unsigned long long> threadAttempts;
+    std::vector<double> threadHashRates;  // hashes per second, one entry per thread
+    bool interrupted = false;             // Search was stopped before any valid nonce was found
+
+    double hashRate() const;  // combined hashes per second
+};
 
 class Block {
 private:
     int index;
     long long timestamp;
-    std::string previousHash;
-    std::string hash;
-    std::string merkleRoot;
+    Hash256 previousHash;
+    Hash256 hash;
+    Hash256 merkleRoot;
     int nonce;
-    std::vector<Transaction> transactions;
+    TransactionColumns transactions;
+    size_t transactionCount;  // Kept separately so header-only blocks still report it
+
+    Hash256 calculateHash(int nonceValue) const;
 
 public:
-    Block(int idx, const std::vector<Transaction>& txs, const std::string& prevHash);
+    Block(int idx, const std::vector<Transaction>& txs, const Hash256& prevHash);
+    // resource backs the transaction columns and the Merkle build (e.g. a BlockArena);
+    // copies of the block always allocate from the default heap
+    Block(int idx, const std::vector<Transaction>& txs, const Hash256& prevHash, long long fixedTimestamp,
+          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-    std::string calculateHash() const;
-    void mineBlock(int difficulty);
+    // Restores a previously mined block from its header (no re-mining or Merkle rebuild)
+    Block(const BlockHeader& header, TransactionColumns txs);
+    // Header-only block: transactions stay on disk, only their count is known
+    Block(const BlockHeader& header, size_t txCount);
+    // Same, trusting a hash recorded alongside the header instead of rehashing
+    Block(const BlockHeader& header, const Hash256& knownHash, size_t txCount);
+
+    Hash256 calculateHash() const;
+    // Ids (Transaction::getId) of every transaction in order, hashed as one batch
+    std::pmr::vector<Hash256> calculateTransactionHashes(std::pmr::memory_resource* resource) const;
+
+    // Searches for a nonce meeting the difficulty target. With threadCount > 1 the
+    // nonce space is interleaved across workers; the lowest valid nonce always wins,
+    // so the result matches the single-threaded search. Setting *interrupt stops the
+    // workers within a few thousand hashes; the block is left unsealed unless a valid
+    // nonce had already been found.
+    MiningStats mineBlock(int difficulty, unsigned int threadCount = 1,
+                          const std::atomic<bool>* interrupt = nullptr);
+
+    // Self-contained checks: stored hash, proof-of-work target (except genesis),
+    // Merkle root and transaction validity. Linkage is checked by Blockchain.
+    bool isValid(int difficulty) const;
 
     // Getters
-    std::string getHash() const;
-    std::string getPreviousHash() const;
-    std::vector<Transaction> getTransactions() const;
+    const Hash256& getHash() const;
+    const Hash256& getPreviousHash() const;
+    const Hash256& getMerkleRoot() const;
+
+    // Inclusion proof for transactions[txIndex] against this block's Merkle root;
+    // the leaf is tx.getId()
+    MerkleProof getMerkleProof(size_t txIndex) const;
+    const TransactionColumns& getTransactions() const;  // Empty for header-only blocks
+    size_t getTransactionCount() const;
+    bool isHeaderOnly() const;  // Transactions were left in the block store
+    BlockHeader getHeader() const;
     long long getTimestamp() const;
     int getIndex() const;
+    int getNonce() const;
 };
 
 #endif
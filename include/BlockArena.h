@@ -0,0 +1,28 @@
+// include/BlockArena.h
+#ifndef BLOCK_ARENA_H
+#define BLOCK_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+// Monotonic arena scoped to assembling one block. Transaction columns, hashing
+// buffers and Merkle levels bump-allocate from one upfront buffer sized from the
+// transaction count; nothing is freed until the arena goes away, which releases
+// everything at once. Not thread-safe: one arena per block under construction.
+class BlockArena {
+private:
+    std::pmr::monotonic_buffer_resource resource;
+
+public:
+    explicit BlockArena(std::size_t transactionCount);
+
+    BlockArena(const BlockArena&) = delete;
+    BlockArena& operator=(const BlockArena&) = delete;
+
+    std::pmr::memory_resource* get();
+
+    // Upper estimate of arena bytes used while building a block of this size
+    static std::size_t estimateBytes(std::size_t transactionCount);
+};
+
+#endif
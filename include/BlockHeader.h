@@ -0,0 +1,56 @@
+// include/BlockHeader.h
+#ifndef BLOCK_HEADER_H
+#define BLOCK_HEADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "utils/Hash256.h"
+#include "utils/Sha256.h"
+
+// Fixed-layout binary block header hashed for proof-of-work.
+// All integers are little-endian; the nonce is the last field so the first
+// 64 bytes (one SHA-256 block) never change while mining.
+//
+//   offset  size  field
+//        0     4  index
+//        4     8  timestamp (Unix epoch seconds)
+//       12    32  previous block hash
+//       44    32  Merkle root
+//       76     4  nonce
+struct BlockHeader {
+    static constexpr std::size_t SIZE = 80;
+    static constexpr std::size_t NONCE_OFFSET = 76;
+
+    unsigned char bytes[SIZE];
+
+    BlockHeader(int index, long long timestamp, const Hash256& previousHash,
+                const Hash256& merkleRoot, int nonce);
+
+    static BlockHeader fromBytes(const unsigned char* data);  // Reads SIZE bytes
+
+    int getIndex() const;
+    long long getTimestamp() const;
+    Hash256 getPreviousHash() const;
+    Hash256 getMerkleRoot() const;
+    int getNonce() const;
+
+    void setNonce(int nonce);
+
+private:
+    BlockHeader() = default;
+};
+
+// Caches the SHA-256 state after the constant first 64 header bytes so each
+// nonce attempt costs a single compression and no heap allocation.
+class HeaderHasher {
+private:
+    Sha256 midstate;
+    unsigned char finalBlock[64];  // Header tail with SHA-256 padding; nonce patched in place
+
+public:
+    explicit HeaderHasher(const BlockHeader& header);
+
+    void hash(int nonce, Hash256& digest);
+};
+
+#endif // BLOCK_HEADER_H
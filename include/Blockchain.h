@@ -2,36 +2,206 @@
 #ifndef BLOCKCHAIN_H
 #define BLOCKCHAIN_H
 
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <mutex>
 #include <vector>
 #include <string>
+#include <memory>
+#include <memory_resource>
+#include <shared_mutex>
 #include "Block.h"
+#include "ChainIndex.h"
+#include "ChainSnapshot.h"
+#include "ChainView.h"
+#include "Mempool.h"
 #include "Transaction.h"
+#include "storage/BlockStore.h"
+#include "storage/StateSnapshot.h"
+#include "utils/ThreadPool.h"
 
 class Blockchain {
 private:
+    // Outcome of commitBlock; everything but Committed leaves the chain unchanged
+    enum class CommitResult {
+        Committed,
+        Stale,                 // No longer extends the tip
+        InvalidReward,
+        ConfirmedTransaction,  // Repeats a transaction the chain or the block already holds
+        Overspend,             // A sender spends more than its confirmed balance
+        BalanceOverflow
+    };
+
     std::vector<Block> chain;
     int difficulty;
-    std::vector<Transaction> pendingTransactions;
-    double miningReward;
+    std::shared_ptr<Mempool> mempool;  // Replaced whole by setMempoolOptions; read through currentMempool()
+    Amount miningReward;
+    unsigned int miningThreads;
+
+    bool enforceBalances;
+    bool verifySignatures;
+
+    // Tip and confirmed balances, replaced wholesale after every append. Only ever
+    // accessed through std::atomic_load / std::atomic_store; publishedVersion lets
+    // readers notice a new snapshot without touching the pointer's reference count.
+    std::shared_ptr<const ChainSnapshot> snapshot;
+    std::atomic<std::uint64_t> publishedVersion;
+    const std::uint64_t instanceId;  // Tags per-thread snapshot caches
+
+    // Hash, transaction and address lookups for blocks [0, indexedHeight). Appends keep
+    // it current; after a reopen it is rebuilt from the store on a background thread
+    // (indexBuild) that lookups wait for.
+    mutable ChainIndex index;
+    mutable size_t indexedHeight;
+    mutable std::shared_mutex indexMutex;
+
+    // Optional on-disk store; when attached, chain holds header-only blocks
+    std::unique_ptr<BlockStore> store;
+
+    // State snapshots beside the store so a reopen replays only the blocks after the newest
+    std::unique_ptr<StateSnapshotStore> stateSnapshots;
+    unsigned int snapshotInterval;
+    std::future<void> snapshotWrite;  // At most one write in flight
+
+    // commitMutex serializes writers. stateMutex guards chain and store, and is held
+    // exclusively only while a block is pushed; snapshot readers never take it.
+    // Lock order: indexMutex before stateMutex.
+    std::mutex commitMutex;
+    mutable std::shared_mutex stateMutex;
+
+    // Blocks [0, validatedHeight) already passed isChainValid
+    mutable std::atomic<size_t> validatedHeight;
+    unsigned int validationThreads;
+    // Created on first use under validationPoolMutex (validations run concurrently under a
+    // shared stateMutex); only replaced under an exclusive stateMutex
+    mutable std::unique_ptr<ThreadPool> validationPool;
+    mutable std::mutex validationPoolMutex;
+
+    // Declared last so destruction waits for it before the chain and store it reads go away
+    std::shared_future<void> indexBuild;
 
     Block createGenesisBlock();
+    void publish(std::shared_ptr<const ChainSnapshot> next);
+    const ChainSnapshot& currentSnapshot() const;  // Per-thread cached; valid until this thread's next call
+    CommitResult commitBlock(const Block& block, const std::vector<Transaction>& transactions);
+    void writeStateSnapshot(std::shared_ptr<const ChainSnapshot> state);
+    void catchUpIndex() const;
+    std::shared_ptr<Mempool> currentMempool() const;
+    bool hasValidSignatures(const Block& block) const;
+    bool hasValidReward(const Block& block) const;  // Exactly one reward, paying the subsidy plus the block's fees
+    // Ledger rules for a block on top of previous: no transaction the chain already confirmed
+    // and, with balance enforcement, no sender spending more than its confirmed balance.
+    // Returns Committed if the block passes; otherwise collects the offending transactions.
+    CommitResult checkLedgerRules(const Block& block, const ChainSnapshot& previous, const Hash256* ids,
+                                  std::vector<Transaction>& offending) const;
+    bool validateFrom(size_t from) const;
+    ThreadPool& getValidationPool() const;  // Checks blocks [from, end) and advances validatedHeight
 
 public:
-    Blockchain(const std::string& genesisAddress);
+    Blockchain(const Hash256& genesisAddress);
+    // Persistent chain: reopens the block store in dataDirectory (creating it with a
+    // genesis block if empty) and loads only headers, the index and the difficulty. Balances
+    // come from the newest valid state snapshot plus a replay of the blocks after it.
+    Blockchain(const Hash256& genesisAddress, const std::string& dataDirectory,
+               const BlockStoreOptions& options = BlockStoreOptions());
     
-    void addTransaction(const Transaction& transaction);
-    void minePendingTransactions(const std::string& miningRewardAddress);
+    // Admits a transaction to the mempool; safe to call from many threads. Returns false
+    // for duplicates (pending or confirmed), invalid transactions, a full pool that the fee cannot displace, or
+    // (with balance enforcement on) a sender who cannot cover amount + fee
+    bool addTransaction(const Transaction& transaction);
+    // Batch admission: signatures are verified in parallel first; returns how many were accepted
+    size_t addTransactions(const std::vector<Transaction>& transactions);
+    // Mines a block from the highest fee-rate pending transactions within the mempool's
+    // block caps; the reward transaction also collects their fees
+    void minePendingTransactions(const Hash256& miningRewardAddress);
+
+    // Building blocks for miners that seal off the calling thread (see Miner):
+    // the highest fee-rate pending transactions within the block caps, followed by the
+    // reward transaction paying the subsidy plus their fees
+    std::vector<Transaction> selectBlockTransactions(const Hash256& miningRewardAddress) const;
+    // Unsealed block of these transactions on top of the current tip
+    Block createBlockTemplate(const std::vector<Transaction>& transactions,
+                              std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+    // Validates a sealed block and appends it if it still extends the tip; its
+    // transactions leave the mempool. Returns false for invalid or stale blocks.
+    bool submitBlock(const Block& block);
     
-    double getBalanceOfAddress(const std::string& address) const;
+    // Current tip and balances; the snapshot stays valid and unchanged for as long as it is held
+    std::shared_ptr<const ChainSnapshot> getSnapshot() const;
+
+    Amount getBalanceOfAddress(const Hash256& address) const;  // Lock-free, from the latest snapshot
+
+    // Confirmed balance minus amount + fee the address already spends in pending transactions
+    Amount getSpendableBalance(const Hash256& address) const;
+    bool hasSufficientBalance(const Hash256& address, Amount amount) const;
     
+    // Validates blocks appended since the last successful call: per-block checks run
+    // in parallel on the validation pool, linkage in one sequential pass
     bool isChainValid() const;
+    bool revalidateChain() const;  // Forgets prior results and validates from genesis
     void printChain() const;
     
-    // Getters
-    Block getLatestBlock() const;
-    std::vector<Block> getChain() const;
+    // Getters. While a Miner runs, prefer getSnapshot(), the balance queries, indexed
+    // lookups and validation; accessors returning references into the chain need mining paused.
+    Block getBlock(size_t height) const;  // Full block, read from the store if only its header is resident
+    const Block& getLatestBlock() const;
+    const std::vector<Block>& getChain() const;
+    size_t getBlockCount() const;  // Lock-free
+
+    // Views stay valid until the next block is appended. Resident blocks are header-only
+    // when a block store is attached; the transaction range reads those from the store.
+    BlockRange getBlocks() const;
+    BlockRange getBlocks(size_t fromHeight, size_t toHeight) const;  // Heights [from, to)
+    TransactionRange getTransactions() const;
+    TransactionRange getTransactions(size_t fromHeight, size_t toHeight) const;
     int getDifficulty() const;
-    std::vector<Transaction> getPendingTransactions() const;
+    unsigned int getMiningThreads() const;
+
+    // Indexed lookups; safe while a Miner runs
+    bool findBlockHeight(const Hash256& hash, size_t& height) const;
+    bool findTransaction(const Hash256& id, TransactionLocation& location) const;
+    Transaction getTransaction(const TransactionLocation& location) const;  // Throws std::out_of_range
+    // Confirmed transactions sending to or from address, oldest first; offset/limit page through long histories
+    std::vector<TransactionLocation> getAddressHistory(const Hash256& address, size_t offset = 0,
+                                                       size_t limit = std::numeric_limits<size_t>::max()) const;
+
+    // For light clients (see LightClient): headers for heights [from, to), clamped to the
+    // tip, and the Merkle proof placing a confirmed transaction in its block
+    std::vector<BlockHeader> getHeaders(size_t fromHeight, size_t toHeight) const;
+    bool getTransactionProof(const Hash256& id, TransactionLocation& location, MerkleProof& proof) const;
+
+    // Leading zero hex digits required of block hashes (default 2). Validation applies it to
+    // every block, so set it before mining the first one. Persistent chains record it in
+    // the block store and restore it on reopen.
+    void setDifficulty(int difficulty);
+
+    // Reject pending transactions whose sender lacks the funds (off by default)
+    void setBalanceEnforcement(bool enabled);
+
+    // Require a valid sender signature on every non-reward transaction, both for admission
+    // and chain validation (off by default). Senders' keys must be registered first.
+    void setSignatureVerification(bool enabled);
+    Hash256 registerPublicKey(const std::string& publicKeyPem);
+
+    // Replaces the mempool limits; pending transactions are carried over where they fit.
+    // Admissions racing the swap may land in the old pool and be dropped.
+    void setMempoolOptions(const MempoolOptions& options);
+    // The current pool; holders keep it alive across a setMempoolOptions swap, so fetch
+    // it again rather than caching it for long
+    std::shared_ptr<const Mempool> getMempool() const;
+
+    // Persistent chains write a state snapshot every `blocks` appended blocks (default
+    // 1000, 0 disables); writes run in the background from the published snapshot
+    void setStateSnapshotInterval(unsigned int blocks);
+
+    // Worker threads for chain validation; 0 selects one per hardware thread
+    void setValidationThreads(unsigned int threads);
+
+    // Number of proof-of-work worker threads; 0 selects one per hardware thread
+    void setMiningThreads(unsigned int threads);
+    std::vector<Transaction> getPendingTransactions() const;  // Copy: the mempool keeps changing
 };
 
 #endif // BLOCKCHAIN_H
@@ -0,0 +1,40 @@
+// include/ChainIndex.h
+#ifndef CHAIN_INDEX_H
+#define CHAIN_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Block.h"
+#include "utils/Hash256.h"
+
+struct TransactionLocation {
+    std::uint32_t height;
+    std::uint32_t position;  // Index within the block's transactions
+};
+
+// Lookup tables kept in step with the chain: block hash -> height, transaction
+// id -> location, and address -> every location where it sends or receives.
+// Lookups are single hash probes; histories grow in chain order. Not thread-safe:
+// Blockchain updates and reads it under indexMutex, taken before stateMutex.
+class ChainIndex {
+private:
+    std::unordered_map<Hash256, std::uint32_t> heightByHash;
+    std::unordered_map<Hash256, TransactionLocation> locationById;
+    std::unordered_map<Hash256, std::vector<TransactionLocation>> historyByAddress;
+
+public:
+    // Indexes a block at height block.getIndex(); its transactions must be resident
+    void addBlock(const Block& block);
+    // Same, with the ids already computed (block.calculateTransactionHashes)
+    void addBlock(const Block& block, const Hash256* ids);
+    void clear();
+
+    bool findBlock(const Hash256& hash, std::size_t& height) const;
+    // Identical transactions (e.g. two equal rewards within a second) keep their first location
+    bool findTransaction(const Hash256& id, TransactionLocation& location) const;
+    const std::vector<TransactionLocation>& getHistory(const Hash256& address) const;  // Empty if never seen
+};
+
+#endif
@@ -0,0 +1,32 @@
+// include/ChainSnapshot.h
+#ifndef CHAIN_SNAPSHOT_H
+#define CHAIN_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "BalanceTable.h"
+#include "Block.h"
+
+// Immutable view of the chain tip and confirmed balances as of one block. Blockchain
+// publishes a new snapshot atomically after each append; readers keep whichever one
+// they loaded for as long as they hold it, without locks or waiting on the writer.
+class ChainSnapshot {
+private:
+    std::uint64_t version;
+    std::size_t blockCount;
+    std::shared_ptr<const Block> tip;
+    BalanceTable balances;
+
+public:
+    ChainSnapshot(std::uint64_t version, std::size_t blockCount, std::shared_ptr<const Block> tip,
+                  BalanceTable balances);
+
+    std::uint64_t getVersion() const;  // Increases by one per published block
+    std::size_t getBlockCount() const;
+    const Block& getLatestBlock() const;
+    Amount getBalanceOfAddress(const Hash256& address) const;
+    const BalanceTable& getBalances() const;
+};
+
+#endif
@@ -0,0 +1,67 @@
+// include/ChainView.h
+#ifndef CHAIN_VIEW_H
+#define CHAIN_VIEW_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include "Block.h"
+#include "Transaction.h"
+#include "utils/Span.h"
+
+class Blockchain;
+
+// Contiguous view over resident blocks (header-only when a block store is attached)
+using BlockRange = Span<const Block>;
+
+// Walks every transaction in a height range without copying resident blocks. Blocks
+// whose transactions live in the block store are read one at a time as the walk reaches them.
+class TransactionIterator {
+private:
+    const Blockchain* chain;
+    std::size_t blockHeight;
+    std::size_t endHeight;
+    std::size_t position;
+    const Block* current;
+    std::shared_ptr<const Block> loaded;  // Holds a store-backed block while it is being walked
+    std::optional<Transaction> row;       // Current row assembled from the block's columns
+
+    void settle();  // Moves to the next block that has transactions, or to the end
+
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Transaction;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Transaction*;
+    using reference = const Transaction&;
+
+    TransactionIterator(const Blockchain* chain, std::size_t height, std::size_t endHeight);
+
+    reference operator*() const;
+    pointer operator->() const;
+    TransactionIterator& operator++();
+    TransactionIterator operator++(int);
+
+    bool operator==(const TransactionIterator& other) const;
+    bool operator!=(const TransactionIterator& other) const;
+
+    std::size_t height() const;  // Height of the block holding the current transaction
+    std::size_t index() const;   // Position of the current transaction within its block
+    const Block& block() const;
+};
+
+class TransactionRange {
+private:
+    const Blockchain* chain;
+    std::size_t fromHeight;
+    std::size_t toHeight;
+
+public:
+    TransactionRange(const Blockchain* chain, std::size_t from, std::size_t to);
+
+    TransactionIterator begin() const;
+    TransactionIterator end() const;
+};
+
+#endif
@@ -0,0 +1,41 @@
+// include/KeyPool.h
+#ifndef KEY_POOL_H
+#define KEY_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <openssl/evp.h>
+#include "Wallet.h"
+
+// Generates key pairs on a background thread so wallet creation only pops a ready key
+class KeyPool {
+private:
+    KeyAlgorithm algorithm;
+    std::size_t targetSize;
+    std::deque<EVP_PKEY*> keys;
+    mutable std::mutex mutex;
+    std::condition_variable refill;
+    bool stopping;
+    bool failed;  // Last background keygen threw; the worker idles until the next take()
+    std::thread worker;
+
+    void workerLoop();
+
+public:
+    explicit KeyPool(KeyAlgorithm algorithm = KeyAlgorithm::Ed25519, std::size_t targetSize = 64);
+    ~KeyPool();
+
+    KeyPool(const KeyPool&) = delete;
+    KeyPool& operator=(const KeyPool&) = delete;
+
+    // Caller owns the key; generated inline only if the pool has run dry, in which case
+    // a keygen failure throws std::runtime_error here
+    EVP_PKEY* take();
+    std::size_t available() const;
+    KeyAlgorithm getAlgorithm() const;
+};
+
+#endif
@@ -0,0 +1,46 @@
+// include/LightClient.h
+#ifndef LIGHT_CLIENT_H
+#define LIGHT_CLIENT_H
+
+#include <cstddef>
+#include <vector>
+#include "BlockHeader.h"
+#include "Transaction.h"
+#include "utils/Hash256.h"
+#include "utils/MerkleTree.h"
+
+// Headers-only verifier (SPV). Keeps the 80-byte header of each block from a trusted
+// checkpoint onwards - no transactions, balances or indexes - and checks linkage and
+// proof-of-work on those alone. A transaction counts as confirmed when its Merkle
+// proof (Blockchain::getTransactionProof) leads to the root of a stored header.
+class LightClient {
+private:
+    std::vector<BlockHeader> headers;
+    std::size_t startHeight;
+    Hash256 tipHash;
+    int difficulty;
+
+public:
+    // checkpoint is trusted as-is (usually the genesis header); later headers must
+    // extend it and meet the chain's difficulty
+    LightClient(const BlockHeader& checkpoint, int difficulty);
+
+    // Appends a header that links to the tip, has the next index and meets the
+    // proof-of-work target; returns false and keeps the chain unchanged otherwise
+    bool addHeader(const BlockHeader& header);
+    // Appends in order until the first rejected header; returns how many were added
+    std::size_t addHeaders(const std::vector<BlockHeader>& batch);
+
+    std::size_t getStartHeight() const;   // Height of the checkpoint
+    std::size_t getBlockCount() const;    // Chain length up to the tip, including heights below the checkpoint
+    const BlockHeader& getHeader(std::size_t height) const;  // Throws std::out_of_range
+    const Hash256& getTipHash() const;
+    std::size_t getConfirmations(std::size_t height) const;  // 1 for the tip, 0 for unknown heights
+    std::size_t getMemoryUsage() const;   // Bytes held for headers
+
+    // True if proof places the transaction with this id in the block at height
+    bool verifyTransaction(const Hash256& txId, std::size_t height, const MerkleProof& proof) const;
+    bool verifyTransaction(const Transaction& tx, std::size_t height, const MerkleProof& proof) const;
+};
+
+#endif
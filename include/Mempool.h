@@ -0,0 +1,93 @@
+// include/Mempool.h
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Transaction.h"
+#include "utils/Amount.h"
+#include "utils/Hash256.h"
+
+struct MempoolOptions {
+    std::size_t capacity = 100000;            // Pending transactions held before eviction
+    std::size_t maxBlockTransactions = 1000;  // Block template caps
+    std::size_t maxBlockBytes = 1024 * 1024;
+    unsigned int shards = 16;
+};
+
+enum class AdmitResult {
+    Accepted,
+    Duplicate,
+    Invalid,
+    InsufficientFunds,
+    PoolFull  // Fee rate too low to displace anything while at capacity
+};
+
+// Pending transaction pool. Transactions are sharded by sender, so producers for
+// different senders only contend on their own shard lock; a sender's transactions
+// share a shard, which keeps per-sender order and spend totals consistent.
+class Mempool {
+private:
+    struct Entry {
+        Transaction tx;
+        Hash256 id;
+        std::uint64_t sequence;  // Arrival order
+        std::size_t size;        // Serialized bytes
+        double feeRate;          // Fee per byte
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<Hash256, Entry> byId;
+        std::unordered_map<Hash256, std::deque<Hash256>> bySender;  // Arrival order per sender
+        std::unordered_map<Hash256, Amount> pendingSpends;           // amount + fee per sender
+        std::multimap<double, Hash256> byFeeRate;                    // Eviction order
+    };
+
+    MempoolOptions options;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<std::size_t> count;
+    std::atomic<std::uint64_t> nextSequence;
+    std::atomic<Amount> admittedFees;
+
+    Shard& shardFor(const Hash256& sender) const;
+    static Amount pendingSpendLocked(const Shard& shard, const Hash256& sender);
+    bool eraseLocked(Shard& shard, const Hash256& id);  // Leaves count to the caller
+    bool evictBelow(double feeRate);                    // The evicted entry's slot passes to the caller
+
+public:
+    explicit Mempool(const MempoolOptions& options = MempoolOptions());
+
+    // Thread-safe. spendLimit caps the sender's total pending amount + fee
+    AdmitResult add(const Transaction& tx, Amount spendLimit = std::numeric_limits<Amount>::max());
+
+    bool contains(const Hash256& id) const;
+    std::size_t size() const;
+    Amount getPendingSpend(const Hash256& sender) const;
+
+    // Running totals over every accepted transaction, never decreased; miners compare
+    // them against a template's snapshot to decide when rebuilding pays off
+    std::uint64_t getAdmittedCount() const;
+    Amount getAdmittedFees() const;
+
+    // Highest fee rate first within the block caps, never reordering one sender's transactions
+    std::vector<Transaction> selectForBlock() const;
+    void removeConfirmed(const std::vector<Transaction>& transactions);
+
+    std::vector<Transaction> snapshot() const;  // Arrival order
+    // Visits every pending transaction with its cached id, one shard lock at a time; no order
+    void forEach(const std::function<void(const Hash256&, const Transaction&)>& visit) const;
+
+    const MempoolOptions& getOptions() const;
+};
+
+#endif // MEMPOOL_H
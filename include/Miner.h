@@ -0,0 +1,66 @@
+// include/Miner.h
+#ifndef MINER_H
+#define MINER_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Block.h"
+#include "Blockchain.h"
+#include "utils/Amount.h"
+#include "utils/Hash256.h"
+
+struct MinerOptions {
+    unsigned int threads = 1;                    // Proof-of-work workers per search; 0 = one per hardware thread
+    Amount refreshFees = COIN / 100;             // Newly admitted fees that justify rebuilding the template
+    std::chrono::milliseconds pollInterval{50};  // How often a running search checks the tip and mempool
+};
+
+// Background mining engine. A control thread builds a template from the blockchain's
+// mempool, seals it on a separate search and submits the result. While the search
+// runs it watches the chain: a competing block at the tip abandons the work, and
+// enough new fees in the mempool restart it on a fresh template. Transactions keep
+// flowing into the blockchain the whole time.
+class Miner {
+public:
+    using BlockCallback = std::function<void(const Block&, const MiningStats&)>;
+
+private:
+    Blockchain& blockchain;
+    Hash256 rewardAddress;
+    MinerOptions options;
+
+    mutable std::mutex mutex;
+    std::vector<std::promise<Block>> waiters;
+    BlockCallback onBlock;
+    std::atomic<bool> stopping;
+    std::atomic<unsigned long long> blocksMined;
+    std::thread worker;
+
+    void workerLoop();
+    void publish(const Block& block, const MiningStats& stats);
+
+public:
+    Miner(Blockchain& blockchain, const Hash256& rewardAddress, const MinerOptions& options = MinerOptions());
+    ~Miner();  // Stops mining
+
+    Miner(const Miner&) = delete;
+    Miner& operator=(const Miner&) = delete;
+
+    // Starts the control thread; onBlock runs on it after each block is appended.
+    // Throws std::logic_error if already running.
+    void start(BlockCallback onBlock = nullptr);
+    // Interrupts the current search and joins; pending futures fail with std::runtime_error
+    void stop();
+    bool isRunning() const;
+
+    // Resolves with the next block this miner appends to the chain
+    std::future<Block> nextBlock();
+    unsigned long long getBlocksMined() const;
+};
+
+#endif
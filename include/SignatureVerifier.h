@@ -0,0 +1,70 @@
+// include/SignatureVerifier.h
+#ifndef SIGNATURE_VERIFIER_H
+#define SIGNATURE_VERIFIER_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <openssl/evp.h>
+#include "utils/Hash256.h"
+#include "utils/Signature.h"
+#include "utils/ThreadPool.h"
+
+struct SignatureCheck {
+    Hash256 address;      // Signer's address (SHA-256 of its PEM public key)
+    std::string message;
+    Signature signature;  // Fixed-slot transaction signature
+};
+
+// Signature verification engine. Public keys are registered once per address and
+// kept parsed in an LRU cache of EVP_PKEY handles; each thread reuses its own
+// digest context; verifyBatch spreads independent checks across a thread pool.
+class SignatureVerifier {
+private:
+    std::size_t cacheCapacity;
+    unsigned int threadCount;
+
+    mutable std::mutex mutex;  // Guards the directory and the cache
+    std::unordered_map<Hash256, std::string> publicKeys;  // address -> PEM
+    std::list<std::pair<Hash256, EVP_PKEY*>> recentKeys;  // Most recently used first
+    std::unordered_map<Hash256, std::list<std::pair<Hash256, EVP_PKEY*>>::iterator> cachedKeys;
+
+    std::mutex poolMutex;
+    std::unique_ptr<ThreadPool> pool;
+
+    // Returns an owned reference (caller frees) so eviction cannot pull a key out from under a check
+    EVP_PKEY* acquireKey(const Hash256& address);
+    EVP_PKEY* acquireKeyFromPem(const Hash256& address, const std::string& publicKeyPem);
+    static bool verifyWithKey(EVP_PKEY* key, const std::string& message,
+                              const unsigned char* signature, std::size_t signatureLength);
+    static bool verifyCompact(EVP_PKEY* key, const std::string& message, const Signature& signature);
+
+public:
+    explicit SignatureVerifier(std::size_t cacheCapacity = 4096, unsigned int threadCount = 0);
+    ~SignatureVerifier();
+
+    SignatureVerifier(const SignatureVerifier&) = delete;
+    SignatureVerifier& operator=(const SignatureVerifier&) = delete;
+
+    // Records the key behind an address and returns that address
+    Hash256 registerPublicKey(const std::string& publicKeyPem);
+    bool hasPublicKey(const Hash256& address) const;
+
+    // Checks a fixed-slot transaction signature against a registered address
+    bool verify(const Hash256& address, const std::string& message, const Signature& signature);
+    // Checks a base64 signature as produced by Wallet::signMessage
+    bool verifyPem(const std::string& publicKeyPem, const std::string& message, const std::string& signatureBase64);
+
+    // One result per check, in order; unknown addresses fail
+    std::vector<bool> verifyBatch(const std::vector<SignatureCheck>& checks);
+
+    // Process-wide engine used by Wallet::verifySignature and Blockchain
+    static SignatureVerifier& shared();
+};
+
+#endif // SIGNATURE_VERIFIER_H
@@ -2,29 +2,54 @@
 #ifndef TRANSACTION_H
 #define TRANSACTION_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <type_traits>
+#include "utils/Amount.h"
+#include "utils/Hash256.h"
+#include "utils/Signature.h"
 
+class Wallet;
+
+// Fixed-width transaction: no heap storage, 152 bytes in memory
 class Transaction {
 private:
-    std::string sender;
-    std::string receiver;
-    double amount;
-    std::string timestamp;
-    std::string signature;  // Placeholder for digital signature
+    Hash256 sender;          // Zero for mining rewards
+    Hash256 receiver;
+    Amount amount;
+    Amount fee;              // Paid by the sender to the miner on top of amount
+    std::int64_t timestamp;  // Unix epoch seconds
+    Signature signature;     // All zeros until signed
 
 public:
-    Transaction(std::string sender, std::string receiver, double amount);
+    // sender | receiver | amount | fee | timestamp, integers little-endian
+    static constexpr std::size_t SERIALIZED_SIZE = 2 * Hash256::SIZE + 3 * sizeof(std::int64_t);
+
+    Transaction(const Hash256& sender, const Hash256& receiver, Amount amount, Amount fee = 0);
+    // Restores a stored transaction with its original timestamp and signature
+    Transaction(const Hash256& sender, const Hash256& receiver, Amount amount, Amount fee,
+                std::int64_t timestamp, const Signature& signature);
 
-    std::string getSender() const;
-    std::string getReceiver() const;
-    double getAmount() const;
-    std::string getTimestamp() const;
-    std::string getSignature() const;
+    const Hash256& getSender() const;
+    const Hash256& getReceiver() const;
+    Amount getAmount() const;
+    Amount getFee() const;
+    std::int64_t getTimestamp() const;
+    const Signature& getSignature() const;
+    bool isReward() const;  // Minted by the miner: no sender to debit
 
-    std::string toString() const;  // For hashing/Merkle Root
+    // Canonical encoding: the Merkle leaf preimage and the signed message
+    void serialize(unsigned char* out) const;  // Writes SERIALIZED_SIZE bytes
+    std::string serialize() const;
+    Hash256 getId() const;  // SHA-256 of serialize(), the Merkle leaf
 
     void signTransaction(const std::string& privateKey);  // [Optional for now]
+    // Signs serialize() with the sender's wallet key; the sender must be the wallet's address
+    void signTransaction(const Wallet& wallet);
     bool isValid() const;
 };
 
+static_assert(std::is_trivially_copyable<Transaction>::value, "Transaction must stay flat");
+
 #endif
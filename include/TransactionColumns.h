@@ -0,0 +1,65 @@
+// include/TransactionColumns.h
+#ifndef TRANSACTION_COLUMNS_H
+#define TRANSACTION_COLUMNS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <vector>
+#include "Transaction.h"
+#include "utils/Amount.h"
+#include "utils/Hash256.h"
+#include "utils/Signature.h"
+
+// Structure-of-arrays transaction storage for a block: one contiguous column per
+// field, so scans such as balance aggregation only touch the columns they read.
+// Rows are assembled on demand; Transaction is flat, so that never allocates.
+// Columns draw from a memory resource (a block arena while assembling); copies
+// fall back to the default heap resource.
+struct TransactionColumns {
+    std::pmr::vector<Hash256> senders;
+    std::pmr::vector<Hash256> receivers;
+    std::pmr::vector<Amount> amounts;
+    std::pmr::vector<Amount> fees;
+    std::pmr::vector<std::int64_t> timestamps;
+    std::pmr::vector<Signature> signatures;
+
+    class Iterator {
+    private:
+        const TransactionColumns* columns;
+        std::size_t position;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Transaction;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Transaction;
+
+        Iterator(const TransactionColumns* columns, std::size_t position)
+            : columns(columns), position(position) {}
+
+        Transaction operator*() const { return (*columns)[position]; }
+        Iterator& operator++() { ++position; return *this; }
+        Iterator operator++(int) { Iterator previous = *this; ++position; return previous; }
+        bool operator==(const Iterator& other) const { return position == other.position; }
+        bool operator!=(const Iterator& other) const { return position != other.position; }
+    };
+
+    explicit TransactionColumns(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    explicit TransactionColumns(const std::vector<Transaction>& transactions,
+                                std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    void reserve(std::size_t count);
+    void push_back(const Transaction& tx);
+
+    std::size_t size() const;
+    bool empty() const;
+    Transaction operator[](std::size_t i) const;
+
+    Iterator begin() const;
+    Iterator end() const;
+};
+
+#endif
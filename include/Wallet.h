@@ -4,21 +4,43 @@
 
 #include <string>
 #include <openssl/evp.h> // Declares OpenSSL’s high-level EVP API
+#include "utils/Hash256.h"
+#include "utils/Signature.h"
+
+enum class KeyAlgorithm {
+    Rsa2048,    // Slow keygen, 256-byte signatures: too large for a transaction signature slot
+    Ed25519,    // Fast keygen and signing, 64-byte signatures
+    Secp256k1   // ECDSA over the Bitcoin curve, 64 bytes as r || s
+};
+
+class KeyPool;
 
 class Wallet {
 private:
     EVP_PKEY* keyPair;  // OpenSSL key pair for public and private keys
+    KeyAlgorithm algorithm;
 
 public:
-    Wallet();  // Constructor generates key pair
+    explicit Wallet(KeyAlgorithm algorithm = KeyAlgorithm::Ed25519);  // Constructor generates key pair
+    explicit Wallet(KeyPool& pool);  // Takes a pre-generated key pair
+    explicit Wallet(const Hash256& seed);  // Ed25519 key derived from a 32-byte seed, for reproducible runs
     ~Wallet(); // Destructor to free keyPair
 
+    Wallet(const Wallet&) = delete;
+    Wallet& operator=(const Wallet&) = delete;
+
+    KeyAlgorithm getAlgorithm() const;
     std::string getPublicKey() const;
     std::string getPrivateKey() const;  // Optional: for testing
-    std::string getAddress() const;     // SHA-256 hash of public key
+    Hash256 getAddress() const;         // SHA-256 hash of public key
 
-    std::string signMessage(const std::string& message) const;
+    std::string signMessage(const std::string& message) const;  // Base64, any key algorithm
+    // Fixed-slot signature for transactions; throws std::logic_error for RSA keys
+    Signature signCompact(const std::string& message) const;
     static bool verifySignature(const std::string& publicKeyPem, const std::string& message, const std::string& signatureBase64);
+
+    static EVP_PKEY* generateKey(KeyAlgorithm algorithm);  // Caller owns the returned key
+    static const char* algorithmName(KeyAlgorithm algorithm);
 };
 
 #endif
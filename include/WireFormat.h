@@ -0,0 +1,115 @@
+// include/WireFormat.h
+#ifndef WIRE_FORMAT_H
+#define WIRE_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Block.h"
+#include "BlockHeader.h"
+#include "Transaction.h"
+#include "utils/Amount.h"
+#include "utils/Hash256.h"
+#include "utils/Signature.h"
+#include "utils/Span.h"
+
+// Compact, versioned binary encoding for storage and relay.
+//
+//   header       = version (u8) | 80 header bytes
+//   block        = version (u8) | 80 header bytes | varint tx count | transaction*
+//   transaction  = flags (u8) | [sender 32] | receiver 32 | varint amount | varint fee
+//                  | varint timestamp | [signature 64]
+//
+// Varints are LEB128; amount, fee and timestamp are zigzag-mapped first. Flag bit 0
+// marks a reward (no sender), bit 1 an unsigned transaction (no signature). Decoding
+// is strict - unknown versions or flags, overlong varints and trailing bytes are
+// rejected - so every value has exactly one encoding. Hashes and signatures stay
+// defined over the fixed-width forms (BlockHeader bytes, Transaction::serialize),
+// which TransactionView can produce without building a Transaction.
+class WireFormat {
+public:
+    static constexpr std::uint8_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 1 + BlockHeader::SIZE;
+    static constexpr std::size_t MAX_VARINT_SIZE = 10;
+    static constexpr std::size_t MAX_TRANSACTION_SIZE =
+        1 + 2 * Hash256::SIZE + 3 * MAX_VARINT_SIZE + SIGNATURE_SIZE;
+
+    static std::size_t varintSize(std::uint64_t value);
+    static unsigned char* putVarint(unsigned char* out, std::uint64_t value);
+    // Advances cursor past the varint; throws std::runtime_error if truncated or overlong
+    static std::uint64_t readVarint(const unsigned char*& cursor, const unsigned char* end);
+    static std::uint64_t zigzag(std::int64_t value);
+    static std::int64_t unzigzag(std::uint64_t value);
+
+    static unsigned char* encodeHeader(const BlockHeader& header, unsigned char* out);  // Writes HEADER_SIZE bytes
+    static BlockHeader decodeHeader(const unsigned char* data, std::size_t size);
+
+    static std::size_t encodedSize(const Transaction& tx);
+    static unsigned char* encode(const Transaction& tx, unsigned char* out);
+    static std::vector<unsigned char> encode(const Transaction& tx);
+    static Transaction decodeTransaction(const unsigned char* data, std::size_t size);
+
+    // Full blocks only; header-only blocks have no transactions to encode
+    static std::size_t encodedSize(const Block& block);
+    static unsigned char* encode(const Block& block, unsigned char* out);  // Writes encodedSize(block) bytes
+    static std::vector<unsigned char> encode(const Block& block);
+    static Block decodeBlock(const unsigned char* data, std::size_t size);
+};
+
+// One encoded transaction, read in place. Fixed-width fields point into the buffer;
+// the three varints are decoded while parsing. Valid while the buffer is.
+class TransactionView {
+private:
+    const unsigned char* start;
+    const unsigned char* sender;     // nullptr for rewards
+    const unsigned char* receiver;
+    const unsigned char* signature;  // nullptr when unsigned
+    Amount amount;
+    Amount fee;
+    std::int64_t timestamp;
+    std::size_t length;
+
+public:
+    TransactionView();
+
+    // Parses the transaction at data; returns the byte after it. Throws
+    // std::runtime_error if the bytes are truncated or malformed.
+    const unsigned char* parse(const unsigned char* data, const unsigned char* end);
+
+    Span<const unsigned char> encoded() const;  // The exact wire bytes, for forwarding
+    bool isReward() const;
+    bool isSigned() const;
+    Hash256 getSender() const;  // Zero for rewards
+    Hash256 getReceiver() const;
+    Amount getAmount() const;
+    Amount getFee() const;
+    std::int64_t getTimestamp() const;
+    Signature getSignature() const;  // All zeros when unsigned
+
+    void serialize(unsigned char* out) const;  // Same bytes as Transaction::serialize
+    Hash256 getId() const;
+    Transaction toTransaction() const;
+};
+
+// Walks an encoded block without materializing it
+class BlockReader {
+private:
+    const unsigned char* cursor;
+    const unsigned char* end;
+    BlockHeader header;
+    std::size_t transactionCount;
+    std::size_t position;
+
+public:
+    // Reads the version, header and count; throws std::runtime_error if they are malformed
+    BlockReader(const unsigned char* data, std::size_t size);
+
+    const BlockHeader& getHeader() const;
+    std::size_t getTransactionCount() const;
+
+    // Parses the next transaction into tx; false once all have been read (the block
+    // must then end exactly). Throws std::runtime_error on malformed bytes.
+    bool next(TransactionView& tx);
+};
+
+#endif
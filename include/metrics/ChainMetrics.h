@@ -0,0 +1,53 @@
+// include/metrics/ChainMetrics.h
+#ifndef CHAIN_METRICS_H
+#define CHAIN_METRICS_H
+
+#include "metrics/Metrics.h"
+
+enum class AdmitResult;
+
+// The node's metrics, registered once in MetricsRegistry::global(). Hot paths hold
+// these references and only touch atomics.
+struct ChainMetrics {
+    // Proof-of-work: updated once per block, never inside the nonce loop
+    Counter& miningAttempts;
+    Histogram& miningAttemptsPerBlock;
+    Gauge& miningHashRate;
+    Histogram& miningSeconds;
+    Counter& miningRefreshes;  // Searches restarted on a richer block template
+    Counter& miningStale;      // Searches abandoned because another block took the tip
+
+    // Block production
+    Counter& blocksMined;
+    Histogram& blockBuildSeconds;  // Template selection and block assembly
+    Histogram& blockSealSeconds;   // Proof-of-work search
+    Histogram& blockTransactions;
+    Gauge& chainHeight;
+
+    // Mempool admission
+    Gauge& mempoolDepth;
+    Counter& signatureRejected;
+
+    // Validation
+    Histogram& validationSeconds;
+    Counter& blocksValidated;
+    Counter& validationFailures;
+
+    // Signature engine
+    Counter& signaturesValid;
+    Counter& signaturesInvalid;
+    Counter& keyCacheHits;
+    Counter& keyCacheMisses;
+    Histogram& signatureBatchSeconds;
+
+    void recordAdmission(AdmitResult result);
+
+    static ChainMetrics& get();
+
+private:
+    Counter* admissions[5];  // Indexed by AdmitResult
+
+    ChainMetrics();
+};
+
+#endif // CHAIN_METRICS_H
@@ -0,0 +1,94 @@
+// include/metrics/Metrics.h
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Monotonic event count
+class Counter {
+private:
+    std::atomic<std::uint64_t> value{0};
+
+public:
+    void inc(std::uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+    std::uint64_t get() const { return value.load(std::memory_order_relaxed); }
+};
+
+// Value that can go up and down
+class Gauge {
+private:
+    std::atomic<double> value{0.0};
+
+public:
+    void set(double v) { value.store(v, std::memory_order_relaxed); }
+    void add(double delta);
+    double get() const { return value.load(std::memory_order_relaxed); }
+};
+
+// Fixed-bucket distribution; observe() is a bucket search plus three relaxed atomic updates
+class Histogram {
+private:
+    std::vector<double> bounds;  // Upper bounds, ascending; +Inf is implicit
+    std::unique_ptr<std::atomic<std::uint64_t>[]> buckets;  // Non-cumulative counts, one extra for +Inf
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<double> sum{0.0};
+
+public:
+    explicit Histogram(std::vector<double> bounds);
+
+    void observe(double value);
+
+    const std::vector<double>& getBounds() const { return bounds; }
+    std::uint64_t getBucketCount(std::size_t bucket) const;  // bucket == bounds.size() is +Inf
+    std::uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    double getSum() const { return sum.load(std::memory_order_relaxed); }
+
+    static std::vector<double> exponentialBuckets(double start, double factor, std::size_t count);
+    static std::vector<double> latencyBuckets();  // 10us .. ~40s
+};
+
+// Process-wide set of named metrics. Registration takes a lock and returns a reference
+// that stays valid for the registry's lifetime, so call sites look a metric up once and
+// then only touch atomics. Re-registering the same name and labels returns the same metric.
+class MetricsRegistry {
+private:
+    enum class Kind { Counter, Gauge, Histogram };
+
+    struct Series {
+        std::string name;
+        std::string labels;  // e.g. reason="duplicate"; empty for none
+        std::string help;
+        Kind kind;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    mutable std::mutex mutex;
+    std::deque<Series> series;  // Registration order; deque keeps references stable
+
+    Series* find(const std::string& name, const std::string& labels, Kind kind);
+
+public:
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         const std::vector<double>& bounds = Histogram::latencyBuckets(),
+                         const std::string& labels = "");
+
+    // Prometheus text exposition format (version 0.0.4)
+    std::string toPrometheus() const;
+    // Writes atomically (temp file + rename), suitable for a node_exporter textfile collector
+    void writeToFile(const std::string& path) const;
+
+    static MetricsRegistry& global();
+};
+
+#endif // METRICS_H
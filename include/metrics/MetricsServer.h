@@ -0,0 +1,36 @@
+// include/metrics/MetricsServer.h
+#ifndef METRICS_SERVER_H
+#define METRICS_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "metrics/Metrics.h"
+
+// Minimal HTTP endpoint serving GET /metrics from a registry on a background thread.
+// Binds to the loopback interface only; requests are handled one at a time.
+class MetricsServer {
+private:
+    MetricsRegistry& registry;
+    std::intptr_t listener;  // Socket handle (int on POSIX, SOCKET on Windows)
+    std::uint16_t port;
+    std::atomic<bool> stopping;
+    std::thread worker;
+
+    void serveLoop();
+    void handleClient(std::intptr_t client);
+
+public:
+    // port 0 picks a free port; throws std::runtime_error if the socket cannot be bound
+    explicit MetricsServer(MetricsRegistry& registry, std::uint16_t port = 9464);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    std::uint16_t getPort() const;
+    void stop();
+};
+
+#endif // METRICS_SERVER_H
@@ -0,0 +1,142 @@
+// include/net/Node.h
+#ifndef NET_NODE_H
+#define NET_NODE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Block.h"
+#include "Blockchain.h"
+#include "Transaction.h"
+#include "net/Protocol.h"
+#include "utils/Hash256.h"
+
+struct NodeOptions {
+    bool compactBlocks = true;    // Relay blocks as CompactBlock; false sends every block in full
+    std::size_t maxOrphans = 64;  // Blocks held until their parent arrives; the oldest is evicted when full
+    std::chrono::milliseconds requestTimeout{2000};  // Unanswered GetBlockTransactions fall back to GetBlock elsewhere
+    std::chrono::seconds orphanExpiry{60};           // Orphans whose parent has not arrived by then are dropped
+};
+
+// Relay counters since the node started; byte counts include frame headers
+struct NodeStats {
+    std::uint64_t bytesSent = 0;
+    std::uint64_t bytesReceived = 0;
+    std::uint64_t blockBytesSent = 0;             // Blocks, compact blocks and missing-transaction traffic
+    std::uint64_t transactionBytesSent = 0;
+    std::uint64_t blocksConnected = 0;            // Received from peers and appended
+    std::uint64_t compactBlocksReconstructed = 0; // Rebuilt from the mempool without a round trip
+    std::uint64_t transactionsRequested = 0;      // Missing from the mempool and fetched from the peer
+    std::uint64_t fullBlockFallbacks = 0;         // Rebuilt block failed validation; fetched in full
+    std::uint64_t requestsAbandoned = 0;          // Sender timed out or disconnected; fetched in full elsewhere
+};
+
+// Peer-to-peer relay for one Blockchain over loopback TCP. Transactions are flooded to
+// every other peer on admission; blocks are announced as compact blocks, rebuilt from
+// the local mempool and completed with a GetBlockTransactions round trip when needed.
+// Each peer has a reader and a writer thread; sends are queued, so a slow peer never
+// blocks relay to the others. No fork choice: blocks must extend the local tip.
+class Node {
+public:
+    using BlockHandler = std::function<void(const Block&)>;
+
+    // Listens on 127.0.0.1 (port 0 picks a free port); throws std::runtime_error if it cannot bind
+    explicit Node(Blockchain& chain, const NodeOptions& options = NodeOptions(), std::uint16_t port = 0);
+    ~Node();
+
+    Node(const Node&) = delete;
+    Node& operator=(const Node&) = delete;
+
+    std::uint16_t getPort() const;
+    void connect(std::uint16_t port);  // Outbound connection to a node on this machine
+    std::size_t getPeerCount() const;  // Open connections only
+
+    // Called on a peer's reader thread after each block received from the network is appended.
+    // Set before connecting.
+    void setBlockHandler(BlockHandler handler);
+
+    bool submitTransaction(const Transaction& tx);  // Admits locally, then relays
+    bool submitBlock(const Block& block);           // Appends a locally mined block, then announces it
+
+    NodeStats getStats() const;
+    void stop();
+
+private:
+    struct Peer;
+
+    // Compact block waiting for the transactions its sender was asked for
+    struct PendingBlock {
+        BlockHeader header;
+        std::vector<Transaction> transactions;
+        std::vector<std::size_t> missing;
+        std::shared_ptr<Peer> source;
+        std::chrono::steady_clock::time_point requested;
+        std::vector<std::weak_ptr<Peer>> alternates;  // Other peers that announced it meanwhile
+    };
+
+    struct Orphan {
+        Block block;
+        std::chrono::steady_clock::time_point received;
+    };
+
+    Blockchain& chain;
+    NodeOptions options;
+    std::intptr_t listener;  // Socket handle (int on POSIX, SOCKET on Windows)
+    std::uint16_t port;
+    std::atomic<bool> stopping;
+    std::thread acceptor;
+    BlockHandler blockHandler;
+
+    mutable std::mutex peersMutex;
+    std::vector<std::shared_ptr<Peer>> peers;
+
+    std::mutex blocksMutex;  // Guards inFlight, pending and orphans
+    std::unordered_set<Hash256> inFlight;                // Compact blocks being rebuilt
+    std::unordered_map<Hash256, PendingBlock> pending;   // By block hash
+    std::unordered_map<Hash256, Orphan> orphans;         // By previous hash
+
+    std::atomic<std::uint64_t> bytesSent;
+    std::atomic<std::uint64_t> bytesReceived;
+    std::atomic<std::uint64_t> blockBytesSent;
+    std::atomic<std::uint64_t> transactionBytesSent;
+    std::atomic<std::uint64_t> blocksConnected;
+    std::atomic<std::uint64_t> compactBlocksReconstructed;
+    std::atomic<std::uint64_t> transactionsRequested;
+    std::atomic<std::uint64_t> fullBlockFallbacks;
+    std::atomic<std::uint64_t> requestsAbandoned;
+
+    void acceptLoop();
+    void addPeer(std::intptr_t socket);
+    void reapPeers();  // Joins closed peers' threads, closes their sockets and forgets them
+    void readLoop(const std::shared_ptr<Peer>& peer);
+    void writeLoop(const std::shared_ptr<Peer>& peer);
+    void send(const std::shared_ptr<Peer>& peer, std::shared_ptr<const std::vector<unsigned char>> message);
+    void broadcast(std::shared_ptr<const std::vector<unsigned char>> message, const Peer* except);
+
+    void handleMessage(const std::shared_ptr<Peer>& peer, MessageType type, const std::vector<unsigned char>& payload);
+    void handleTransaction(const std::shared_ptr<Peer>& peer, const Transaction& tx);
+    void handleCompactBlock(const std::shared_ptr<Peer>& peer, const CompactBlock& compact);
+    void handleBlockTransactions(const std::shared_ptr<Peer>& peer, const BlockTransactions& response);
+    void serveBlockTransactions(const std::shared_ptr<Peer>& peer, const BlockTransactionsRequest& request);
+    void serveBlock(const std::shared_ptr<Peer>& peer, const Hash256& hash);
+
+    void abandonRequests(const std::function<bool(const PendingBlock&)>& abandon);
+    void fetchElsewhere(const Hash256& hash, const PendingBlock& block);
+    void expireStale();
+
+    bool completeBlock(const std::shared_ptr<Peer>& peer, const Hash256& hash, const BlockHeader& header,
+                       const std::vector<Transaction>& transactions);
+    bool connectBlock(const Block& block, const Peer* source);
+    void announce(const Block& block, const Peer* except);
+};
+
+#endif // NET_NODE_H
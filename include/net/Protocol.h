@@ -0,0 +1,72 @@
+// include/net/Protocol.h
+#ifndef NET_PROTOCOL_H
+#define NET_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Block.h"
+#include "BlockHeader.h"
+#include "Transaction.h"
+#include "utils/Hash256.h"
+
+// Peer messages. Every message is framed as type (u8) | payload length (u32 LE) | payload;
+// transactions, headers and blocks inside payloads use the WireFormat encoding.
+enum class MessageType : std::uint8_t {
+    Transaction = 1,           // One transaction
+    Block = 2,                 // Full block
+    CompactBlock = 3,          // Header, short transaction ids and the prefilled reward
+    GetBlockTransactions = 4,  // Block hash and the positions a receiver could not fill
+    BlockTransactions = 5,     // Block hash and the requested transactions, in order
+    GetBlock = 6               // Block hash; answered with a full Block
+};
+
+class Protocol {
+public:
+    static constexpr std::size_t FRAME_HEADER_SIZE = 5;
+    static constexpr std::size_t MAX_PAYLOAD_SIZE = 32 * 1024 * 1024;
+    static constexpr std::size_t SHORT_ID_SIZE = 6;
+
+    static std::vector<unsigned char> frame(MessageType type, const std::vector<unsigned char>& payload);
+
+    // 48-bit transaction ids salted with the block hash, so a collision in one block
+    // says nothing about the next
+    static std::uint64_t shortIdKey(const Hash256& blockHash);
+    static std::uint64_t shortId(const Hash256& txId, std::uint64_t key);
+};
+
+// Block relayed as its header plus a short id per transaction; the receiver rebuilds it
+// from its own mempool. The reward transaction is never in a mempool, so it is sent whole.
+// decode() throws std::runtime_error on malformed payloads, like WireFormat.
+struct CompactBlock {
+    BlockHeader header;
+    std::vector<std::pair<std::size_t, Transaction>> prefilled;  // (position, transaction), ascending
+    std::vector<std::uint64_t> shortIds;                          // Every other position, in order
+
+    explicit CompactBlock(const BlockHeader& header);
+
+    static CompactBlock fromBlock(const Block& block);
+    std::size_t getTransactionCount() const;
+
+    std::vector<unsigned char> encode() const;
+    static CompactBlock decode(const unsigned char* data, std::size_t size);
+};
+
+struct BlockTransactionsRequest {
+    Hash256 blockHash;
+    std::vector<std::size_t> positions;  // Ascending
+
+    std::vector<unsigned char> encode() const;
+    static BlockTransactionsRequest decode(const unsigned char* data, std::size_t size);
+};
+
+struct BlockTransactions {
+    Hash256 blockHash;
+    std::vector<Transaction> transactions;  // In the order they were requested
+
+    std::vector<unsigned char> encode() const;
+    static BlockTransactions decode(const unsigned char* data, std::size_t size);
+};
+
+#endif // NET_PROTOCOL_H
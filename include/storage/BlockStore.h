@@ -0,0 +1,92 @@
+// include/storage/BlockStore.h
+#ifndef BLOCK_STORE_H
+#define BLOCK_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Block.h"
+#include "storage/MappedFile.h"
+
+struct BlockStoreOptions {
+    std::size_t segmentSize = 64 * 1024 * 1024;  // Bytes per segment file
+    unsigned int syncInterval = 1;                // fsync every N appended blocks; 0 = only on sync()/close
+};
+
+// Append-only block storage. Blocks in the WireFormat encoding are packed into fixed-size,
+// memory-mapped segment files; a separate fixed-record index maps each height
+// to its segment/offset and keeps the header and hash so a reopen never has to
+// touch transaction data. Index records are checksummed and written only after the
+// segment bytes they point to are synced; a record is the commit point for its block.
+// The index also carries the chain's proof-of-work difficulty, so it survives a reopen
+// whether or not a state snapshot exists.
+class BlockStore {
+public:
+    // Encoded block bytes inside a segment mapping; valid while the store is open
+    struct BlockView {
+        const unsigned char* data;
+        std::size_t size;
+    };
+
+    explicit BlockStore(const std::string& directory, const BlockStoreOptions& options = BlockStoreOptions());
+    ~BlockStore();
+
+    BlockStore(const BlockStore&) = delete;
+    BlockStore& operator=(const BlockStore&) = delete;
+
+    void append(const Block& block);
+    void sync();
+
+    int getDifficulty() const;           // -1 until first set
+    void setDifficulty(int difficulty);  // Durable on return
+
+    std::size_t size() const;
+    const BlockHeader& getHeader(std::size_t height) const;
+    const Hash256& getHash(std::size_t height) const;
+    std::size_t getTransactionCount(std::size_t height) const;
+    bool findHeight(const Hash256& hash, std::size_t& height) const;
+
+    BlockView view(std::size_t height) const;
+    Block readBlock(std::size_t height) const;
+    // One transaction read in place from the mapping; throws std::out_of_range past the block's end
+    Transaction readTransaction(std::size_t height, std::size_t position) const;
+
+    // Streams sender/receiver/amount/fee of each transaction without building Transaction objects
+    void forEachTransfer(std::size_t height,
+                         const std::function<void(const Hash256&, const Hash256&, Amount, Amount)>& visit) const;
+
+private:
+    struct IndexEntry {
+        std::uint32_t segment;
+        std::uint64_t offset;
+        std::uint32_t length;
+        std::uint32_t txCount;
+        BlockHeader header;
+        Hash256 hash;
+    };
+
+    std::string directory;
+    BlockStoreOptions options;
+    int difficulty;
+    std::vector<IndexEntry> entries;
+    std::unordered_map<Hash256, std::size_t> heightByHash;
+    std::vector<std::unique_ptr<MappedFile>> segments;
+    std::FILE* indexFile;
+    std::vector<unsigned char> pendingIndex;  // Records for blocks whose segment bytes are not synced yet
+
+    std::uint64_t tailOffset;       // Next write position in the last segment
+    std::uint64_t unsyncedOffset;   // Start of the unsynced range in the last segment
+    unsigned int unsyncedBlocks;
+
+    std::string segmentPath(std::uint32_t segment) const;
+    void loadIndex();
+    void openSegment(std::uint32_t segment, std::size_t minimumSize);
+    void syncPending();
+};
+
+#endif // BLOCK_STORE_H
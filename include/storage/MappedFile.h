@@ -0,0 +1,36 @@
+// include/storage/MappedFile.h
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-write shared memory mapping of a whole file. The file is created if
+// missing and grown to at least minimumSize bytes before it is mapped.
+class MappedFile {
+private:
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fd;
+#endif
+    unsigned char* mapping;
+    std::size_t length;
+
+public:
+    MappedFile(const std::string& path, std::size_t minimumSize);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    unsigned char* data() { return mapping; }
+    const unsigned char* data() const { return mapping; }
+    std::size_t size() const { return length; }
+
+    // Flushes dirty pages in [offset, offset + count) and waits for the disk
+    void sync(std::size_t offset, std::size_t count);
+};
+
+#endif // MAPPED_FILE_H
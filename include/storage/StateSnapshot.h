@@ -0,0 +1,44 @@
+// include/storage/StateSnapshot.h
+#ifndef STATE_SNAPSHOT_H
+#define STATE_SNAPSHOT_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "BalanceTable.h"
+#include "utils/Hash256.h"
+
+// Confirmed state as of one block: enough to resume without replaying the chain below it
+struct StateSnapshot {
+    std::size_t blockCount = 0;  // Blocks covered; the tip is at height blockCount - 1
+    Hash256 tipHash;
+    int difficulty = 0;
+    BalanceTable balances;
+};
+
+// State snapshot files in a chain data directory, named by block count
+// (state-000000001000.snap). Layout: 8-byte magic | u64 block count | tip hash |
+// i32 difficulty | u64 entry count | (address, i64 balance) entries | SHA-256 of
+// everything before it. Files are written beside the target and renamed into
+// place; only the newest `keep` are retained.
+class StateSnapshotStore {
+private:
+    std::string directory;
+    unsigned int keep;
+
+    std::vector<std::pair<std::size_t, std::string>> list() const;  // (block count, path), newest first
+
+public:
+    explicit StateSnapshotStore(const std::string& directory, unsigned int keep = 2);
+
+    void write(const StateSnapshot& snapshot);
+
+    // Loads the newest snapshot that passes its checksum and for which
+    // matchesChain(blockCount, tipHash) holds; false if there is none
+    bool loadLatest(const std::function<bool(std::size_t, const Hash256&)>& matchesChain,
+                    StateSnapshot& snapshot) const;
+};
+
+#endif // STATE_SNAPSHOT_H
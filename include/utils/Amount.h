@@ -0,0 +1,20 @@
+// include/utils/Amount.h
+#ifndef AMOUNT_H
+#define AMOUNT_H
+
+#include <cstdint>
+#include <string>
+
+// Monetary values are integer base units; one coin is 10^8 units
+using Amount = std::int64_t;
+
+constexpr Amount COIN = 100000000;
+// Largest amount or fee a single transaction may carry; keeps sums of a few of them
+// far from the int64 limits
+constexpr Amount MAX_MONEY = 21000000 * COIN;
+
+Amount coinsToAmount(double coins);               // Rounds to the nearest base unit
+std::string formatAmount(Amount amount);          // "12.5", "-48.3", "300"
+bool checkedAdd(Amount a, Amount b, Amount& sum);  // false (sum untouched) if a + b overflows
+
+#endif // AMOUNT_H
@@ -0,0 +1,32 @@
+// include/utils/Encoding.h
+#ifndef ENCODING_H
+#define ENCODING_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Table-driven hex, base64 and UTC timestamp codecs. Every function writes into a
+// caller-provided buffer, never allocates and keeps no state, so all are thread-safe.
+// Encoders return the end of the written output.
+class Encoding {
+public:
+    static constexpr std::size_t hexSize(std::size_t bytes) { return bytes * 2; }
+    static char* toHex(const unsigned char* data, std::size_t size, char* out);  // Lowercase
+    // Accepts either case; length must be even. Returns false on any other input.
+    static bool fromHex(const char* hex, std::size_t length, unsigned char* out);
+
+    // Standard alphabet with '=' padding and no line breaks
+    static constexpr std::size_t base64Size(std::size_t bytes) { return (bytes + 2) / 3 * 4; }
+    static constexpr std::size_t maxBase64DecodedSize(std::size_t length) { return length / 4 * 3; }
+    static char* toBase64(const unsigned char* data, std::size_t size, char* out);
+    // Strict: length must be a multiple of 4, padding may only end the input and the
+    // bits it leaves unused must be zero.
+    // Writes at most maxBase64DecodedSize(length) bytes and sets written.
+    static bool fromBase64(const char* text, std::size_t length, unsigned char* out, std::size_t& written);
+
+    // "YYYY-MM-DDTHH:MM:SSZ" from Unix seconds, without gmtime or locale
+    static constexpr std::size_t UTC_TIME_SIZE = 20;
+    static char* formatUtcTime(std::int64_t epochSeconds, char* out);
+};
+
+#endif // ENCODING_H
@@ -0,0 +1,49 @@
+// include/utils/Hash256.h
+#ifndef HASH256_H
+#define HASH256_H
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+// 32-byte binary SHA-256 digest. Hex is only produced at display/serialization edges.
+struct Hash256 {
+    static constexpr std::size_t SIZE = 32;
+
+    std::array<unsigned char, SIZE> bytes{};
+
+    unsigned char* data() { return bytes.data(); }
+    const unsigned char* data() const { return bytes.data(); }
+
+    bool isZero() const;
+    int leadingZeroBits() const;  // Proof-of-work target check
+
+    std::string toHex() const;
+    char* toHex(char* out) const;  // Writes SIZE * 2 characters; returns the end
+
+    // Parses a 64-character hex string; returns false (and leaves out untouched) otherwise
+    static bool fromHex(const std::string& hex, Hash256& out);
+
+    bool operator==(const Hash256& other) const { return std::memcmp(bytes.data(), other.bytes.data(), SIZE) == 0; }
+    bool operator!=(const Hash256& other) const { return !(*this == other); }
+    bool operator<(const Hash256& other) const { return std::memcmp(bytes.data(), other.bytes.data(), SIZE) < 0; }
+};
+
+static_assert(std::is_trivially_copyable<Hash256>::value, "Hash256 must stay a plain 32-byte value");
+
+namespace std {
+    template <>
+    struct hash<Hash256> {
+        // Digest bytes are already uniformly distributed, so a prefix is a good bucket key
+        std::size_t operator()(const Hash256& h) const noexcept {
+            std::size_t value;
+            std::memcpy(&value, h.bytes.data(), sizeof(value));
+            return value;
+        }
+    };
+}
+
+#endif // HASH256_H
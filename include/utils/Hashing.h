@@ -1,11 +1,23 @@
 #ifndef HASHING_H
 #define HASHING_H
 
+#include <cstddef>
 #include <string>
+#include <vector>
+#include "utils/Hash256.h"
 
 class Hashing {
 public:
-    static std::string sha256(const std::string& input);
+    static Hash256 sha256(const std::string& input);
+    static Hash256 sha256(const void* data, std::size_t length);
+
+    // Hashes many independent messages in one call using the best SHA-256 backend
+    // the CPU supports (SHA-NI, AVX2 multi-buffer lanes, or scalar)
+    static std::vector<Hash256> sha256Batch(const std::vector<std::string>& inputs);
+    static void sha256Batch(const void* const* data, const std::size_t* lengths, std::size_t count, Hash256* out);
+
+    // Hex digest for display/serialization edges such as wallet addresses
+    static std::string sha256Hex(const std::string& input);
 };
 
 #endif // HASHING_H
@@ -1,13 +1,54 @@
 #ifndef MERKLE_TREE_H
 #define MERKLE_TREE_H
 
+#include <cstddef>
+#include <memory_resource>
 #include <vector>
-#include <string>
+#include "utils/Hash256.h"
 
+// Sibling path from a leaf up to the root, bottom level first
+struct MerkleProof {
+    std::size_t leafIndex = 0;
+    std::size_t leafCount = 0;
+    std::vector<Hash256> siblings;
+};
+
+// Stateful Merkle tree. All levels live back to back in one contiguous buffer
+// (leaves first) sized for a power-of-two leaf capacity, so appending or
+// replacing a leaf only rehashes its path to the root. An odd node at the end
+// of a level is paired with itself. Nodes and build scratch come from the given
+// memory resource, so a block arena can supply them.
 class MerkleTree {
+private:
+    std::pmr::vector<Hash256> nodes;
+    std::pmr::vector<std::size_t> levelOffsets;
+    std::size_t leafCapacity;
+    std::size_t leafCount;
+
+    std::size_t levelSize(std::size_t level) const;
+    void reserveLeaves(std::size_t capacity);
+    void updatePath(std::size_t leafIndex);
+
 public:
+    explicit MerkleTree(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    explicit MerkleTree(const std::vector<Hash256>& leaves);  // Bulk build, one hash batch per level
+    MerkleTree(const Hash256* leaves, std::size_t count,
+               std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    void append(const Hash256& leaf);
+    void replace(std::size_t index, const Hash256& leaf);
+
+    std::size_t size() const;
+    Hash256 getRoot() const;  // All zeros for an empty tree
+
+    MerkleProof getProof(std::size_t index) const;
+    static bool verifyProof(const Hash256& leaf, const MerkleProof& proof, const Hash256& root);
+
     // Computes and returns the Merkle Root from a list of transaction hashes
-    static std::string computeMerkleRoot(const std::vector<std::string>& txHashes);
+    // (all zeros for an empty list)
+    static Hash256 computeMerkleRoot(const std::vector<Hash256>& txHashes);
+    static Hash256 computeMerkleRoot(const Hash256* txHashes, std::size_t count,
+                                     std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 };
 
 #endif // MERKLE_TREE_H
@@ -0,0 +1,48 @@
+// include/utils/Sha256.h
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <cstddef>
+#include <cstdint>
+#include "utils/Hash256.h"
+
+// Self-contained SHA-256 with runtime CPU dispatch. The context is a plain value,
+// so a partially absorbed state (e.g. a block header midstate) can be copied freely.
+class Sha256 {
+public:
+    enum class Backend { Scalar, Avx2, ShaNi };
+
+    Sha256();
+
+    void update(const void* data, std::size_t length);
+    void finalize(Hash256& digest);
+
+    static void hash(const void* data, std::size_t length, Hash256& digest);
+
+    // Fixed-length fast path: after absorbing whole blocks, precompute the padded final
+    // block for a message of totalLength bytes whose last bytes are `tail`; each digest
+    // then costs one compression of a caller-patched copy (used for nonce search)
+    void padFinalBlock(const void* tail, std::size_t tailLength, unsigned char block[64]) const;
+    void finalizeBlock(const unsigned char block[64], Hash256& digest) const;
+
+    // Hashes count independent messages; out must have room for count digests
+    static void hashBatch(const void* const* data, const std::size_t* lengths, std::size_t count, Hash256* out);
+
+    static bool isSupported(Backend backend);
+    static Backend activeBackend();
+    static bool setBackend(Backend backend);  // For benchmarking; false if the CPU lacks it
+    static const char* backendName(Backend backend);
+
+private:
+    std::uint32_t state[8];
+    unsigned char buffer[64];
+    std::uint64_t totalLength;
+    std::size_t bufferLength;
+
+    static void compressScalar(std::uint32_t state[8], const unsigned char* blocks, std::size_t count);
+    static void compressShaNi(std::uint32_t state[8], const unsigned char* blocks, std::size_t count);
+    // One 64-byte block per lane; lanes whose bit is clear in activeMask keep their state
+    static void compress8Avx2(std::uint32_t states[8][8], const unsigned char* const blocks[8], unsigned int activeMask);
+};
+
+#endif // SHA256_H
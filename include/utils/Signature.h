@@ -0,0 +1,13 @@
+// include/utils/Signature.h
+#ifndef SIGNATURE_H
+#define SIGNATURE_H
+
+#include <array>
+#include <cstddef>
+
+// Fixed transaction signature slot: a raw Ed25519 signature or a secp256k1 ECDSA
+// signature as r || s. All zeros means unsigned.
+constexpr std::size_t SIGNATURE_SIZE = 64;
+using Signature = std::array<unsigned char, SIGNATURE_SIZE>;
+
+#endif // SIGNATURE_H
@@ -0,0 +1,48 @@
+// include/utils/Span.h
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Non-owning view over contiguous elements (the subset of C++20 std::span the tree needs).
+// Valid only while the underlying storage is neither destroyed nor reallocated.
+template <typename T>
+class Span {
+private:
+    T* first;
+    std::size_t count;
+
+public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    Span() : first(nullptr), count(0) {}
+    Span(T* data, std::size_t size) : first(data), count(size) {}
+    template <typename U, typename Alloc>
+    Span(const std::vector<U, Alloc>& values) : first(values.data()), count(values.size()) {}
+    template <typename U, typename Alloc>
+    Span(std::vector<U, Alloc>& values) : first(values.data()), count(values.size()) {}
+
+    T* data() const { return first; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    iterator begin() const { return first; }
+    iterator end() const { return first + count; }
+
+    T& operator[](std::size_t i) const { return first[i]; }
+    T& front() const { return first[0]; }
+    T& back() const { return first[count - 1]; }
+
+    Span subspan(std::size_t offset, std::size_t length) const {
+        if (offset > count || length > count - offset) {
+            throw std::out_of_range("Span::subspan range outside view");
+        }
+        return Span(first + offset, length);
+    }
+};
+
+#endif
@@ -5,7 +5,10 @@
 
 class Timestamp {
 public:
-    static std::string getCurrentUTCTime();
+    // Writes Encoding::UTC_TIME_SIZE characters (no terminator) and returns the end
+    static char* getCurrentUTCTime(char* out);
+    static std::string getCurrentUTCTime();  // Allocates; prefer the buffer overload on hot paths
+    static long long getCurrentEpochSeconds();
 };
 
 #endif // TIMESTAMP_H
@@ -0,0 +1,70 @@
+// src/BalanceTable.cpp
+#include "BalanceTable.h"
+
+Amount BalanceTable::get(const Hash256& address) const {
+    const std::shared_ptr<Inner>& inner = root[address.bytes[Hash256::SIZE - 1]];
+    if (!inner) return 0;
+    const std::shared_ptr<Leaf>& leaf = inner->leaves[address.bytes[Hash256::SIZE - 2]];
+    if (!leaf) return 0;
+    auto it = leaf->find(address);
+    return it != leaf->end() ? it->second : 0;
+}
+
+BalanceTable::Leaf& BalanceTable::writableLeaf(const Hash256& address) {
+    // A node referenced only from this table can be changed in place; shared ones are
+    // copied first so other tables keep seeing the old values
+    std::shared_ptr<Inner>& inner = root[address.bytes[Hash256::SIZE - 1]];
+    if (!inner) {
+        inner = std::make_shared<Inner>();
+    } else if (inner.use_count() > 1) {
+        inner = std::make_shared<Inner>(*inner);
+    }
+
+    std::shared_ptr<Leaf>& leaf = inner->leaves[address.bytes[Hash256::SIZE - 2]];
+    if (!leaf) {
+        leaf = std::make_shared<Leaf>();
+    } else if (leaf.use_count() > 1) {
+        leaf = std::make_shared<Leaf>(*leaf);
+    }
+    return *leaf;
+}
+
+void BalanceTable::add(const Hash256& address, Amount delta) {
+    writableLeaf(address)[address] += delta;
+}
+
+bool BalanceTable::applyBlock(const TransactionColumns& transactions) {
+    // Fees reach the miner through the reward transaction
+    for (size_t i = 0; i < transactions.size(); i++) {
+        if (!transactions.senders[i].isZero()) {
+            Amount debit;
+            if (!checkedAdd(transactions.amounts[i], transactions.fees[i], debit) || debit < 0) return false;
+            Amount& balance = writableLeaf(transactions.senders[i])[transactions.senders[i]];
+            if (!checkedAdd(balance, -debit, balance)) return false;
+        }
+        Amount& balance = writableLeaf(transactions.receivers[i])[transactions.receivers[i]];
+        if (!checkedAdd(balance, transactions.amounts[i], balance)) return false;
+    }
+    return true;
+}
+
+std::size_t BalanceTable::size() const {
+    std::size_t count = 0;
+    for (const auto& inner : root) {
+        if (!inner) continue;
+        for (const auto& leaf : inner->leaves) {
+            if (leaf) count += leaf->size();
+        }
+    }
+    return count;
+}
+
+void BalanceTable::forEach(const std::function<void(const Hash256&, Amount)>& visit) const {
+    for (const auto& inner : root) {
+        if (!inner) continue;
+        for (const auto& leaf : inner->leaves) {
+            if (!leaf) continue;
+            for (const auto& entry : *leaf) visit(entry.first, entry.second);
+        }
+    }
+}
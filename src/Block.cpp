@@ -1,56 +1,220 @@
 // src/Block.cpp
 #include "Block.h"
+#include "BlockArena.h"
+#include "BlockHeader.h"
+#include "metrics/ChainMetrics.h"
 #include "utils/Hashing.h"
 #include "utils/Timestamp.h"
 #include "utils/MerkleTree.h"
 
-#include <sstream>
-#include <iomanip>
 #include <chrono>
+#include <atomic>
+#include <climits>
+#include <thread>
 
-Block::Block(int idx, const std::vector<Transaction>& txs, const std::string& prevHash)
-    : index(idx), transactions(txs), previousHash(prevHash), nonce(0)
+double MiningStats::hashRate() const {
+    return elapsedSeconds > 0.0 ? attempts / elapsedSeconds : 0.0;
+}
+
+Block::Block(int idx, const std::vector<Transaction>& txs, const Hash256& prevHash)
+    : Block(idx, txs, prevHash, Timestamp::getCurrentEpochSeconds())  // Current timestamp as Unix epoch
+{
+}
+
+Block::Block(int idx, const std::vector<Transaction>& txs, const Hash256& prevHash, long long fixedTimestamp,
+             std::pmr::memory_resource* resource)
+    : index(idx), timestamp(fixedTimestamp), previousHash(prevHash), nonce(0), transactions(txs, resource),
+      transactionCount(txs.size())
 {
-    // Get current timestamp as Unix epoch
-    auto now = std::chrono::system_clock::now();
-    timestamp = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
-    
     // Compute Merkle root from transaction hashes
-    std::vector<std::string> txHashes;
-    for (const auto& tx : transactions) {
-        txHashes.push_back(Hashing::sha256(tx.toString()));
-    }
-    merkleRoot = MerkleTree::computeMerkleRoot(txHashes);
+    std::pmr::vector<Hash256> txHashes = calculateTransactionHashes(resource);
+    merkleRoot = MerkleTree::computeMerkleRoot(txHashes.data(), txHashes.size(), resource);
     
     hash = calculateHash();
 }
 
-std::string Block::calculateHash() const {
-    std::stringstream ss;
-    ss << index << timestamp << previousHash << merkleRoot << nonce;
-    return Hashing::sha256(ss.str());
+Block::Block(const BlockHeader& header, TransactionColumns txs)
+    : index(header.getIndex()), timestamp(header.getTimestamp()), previousHash(header.getPreviousHash()),
+      merkleRoot(header.getMerkleRoot()), nonce(header.getNonce()), transactions(std::move(txs))
+{
+    transactionCount = transactions.size();
+    hash = calculateHash();
+}
+
+Block::Block(const BlockHeader& header, size_t txCount)
+    : Block(header, TransactionColumns())
+{
+    transactionCount = txCount;
+}
+
+Block::Block(const BlockHeader& header, const Hash256& knownHash, size_t txCount)
+    : index(header.getIndex()), timestamp(header.getTimestamp()), previousHash(header.getPreviousHash()),
+      hash(knownHash), merkleRoot(header.getMerkleRoot()), nonce(header.getNonce()), transactionCount(txCount)
+{
+}
+
+std::pmr::vector<Hash256> Block::calculateTransactionHashes(std::pmr::memory_resource* resource) const {
+    // Serialize every transaction into one buffer and hash them as a batch
+    const size_t count = transactions.size();
+    std::pmr::vector<unsigned char> serialized(count * Transaction::SERIALIZED_SIZE, resource);
+    std::pmr::vector<const void*> messages(count, resource);
+    std::pmr::vector<size_t> lengths(count, Transaction::SERIALIZED_SIZE, resource);
+    for (size_t i = 0; i < count; i++) {
+        unsigned char* out = serialized.data() + i * Transaction::SERIALIZED_SIZE;
+        transactions[i].serialize(out);
+        messages[i] = out;
+    }
+
+    std::pmr::vector<Hash256> hashes(count, resource);
+    Hashing::sha256Batch(messages.data(), lengths.data(), count, hashes.data());
+    return hashes;
+}
+
+Hash256 Block::calculateHash() const {
+    return calculateHash(nonce);
+}
+
+Hash256 Block::calculateHash(int nonceValue) const {
+    BlockHeader header = getHeader();
+    header.setNonce(nonceValue);
+    return Hashing::sha256(header.bytes, BlockHeader::SIZE);
+}
+
+MiningStats Block::mineBlock(int difficulty, unsigned int threadCount, const std::atomic<bool>* interrupt) {
+    if (threadCount == 0) threadCount = 1;
+
+    // Difficulty counts leading hex zeros, i.e. four zero bits each
+    const int targetBits = difficulty * 4;
+    const BlockHeader header(index, timestamp, previousHash, merkleRoot, 0);
+    std::atomic<int> winningNonce{INT_MAX};
+
+    MiningStats stats;
+    stats.threads = threadCount;
+    stats.threadAttempts.assign(threadCount, 0);
+    stats.threadHashRates.assign(threadCount, 0.0);
+
+    // Worker t tries nonces t+1, t+1+N, t+1+2N, ... and stops once it passes the
+    // best nonce found so far, so every smaller candidate is still checked.
+    auto worker = [&](unsigned int t) {
+        auto start = std::chrono::steady_clock::now();
+        HeaderHasher hasher(header);
+        Hash256 digest;
+        unsigned long long attempts = 0;
+        for (long long n = 1 + t; n < winningNonce.load(std::memory_order_relaxed); n += threadCount) {
+            ++attempts;
+            hasher.hash(static_cast<int>(n), digest);
+            if (digest.leadingZeroBits() >= targetBits) {
+                int best = winningNonce.load(std::memory_order_relaxed);
+                while (n < best && !winningNonce.compare_exchange_weak(best, static_cast<int>(n))) {
+                }
+                break;
+            }
+            // Polled every 4096 hashes to keep the flag's cache line out of the loop
+            if (interrupt && (attempts & 0xFFF) == 0 && interrupt->load(std::memory_order_relaxed)) break;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        stats.threadAttempts[t] = attempts;
+        stats.threadHashRates[t] = elapsed.count() > 0.0 ? attempts / elapsed.count() : 0.0;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    if (threadCount == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount);
+        for (unsigned int t = 0; t < threadCount; ++t) {
+            workers.emplace_back(worker, t);
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    stats.elapsedSeconds = elapsed.count();
+    for (auto a : stats.threadAttempts) {
+        stats.attempts += a;
+    }
+
+    // Published once per block so the nonce loop stays free of shared writes
+    ChainMetrics& metrics = ChainMetrics::get();
+    metrics.miningAttempts.inc(stats.attempts);
+
+    if (winningNonce.load() == INT_MAX) {
+        // Interrupted (or, in theory, the nonce space ran out) before any hit
+        stats.interrupted = true;
+        return stats;
+    }
+
+    nonce = winningNonce.load();
+    hash = calculateHash();
+    metrics.miningAttemptsPerBlock.observe(static_cast<double>(stats.attempts));
+    metrics.miningHashRate.set(stats.hashRate());
+    metrics.miningSeconds.observe(stats.elapsedSeconds);
+    return stats;
 }
 
-void Block::mineBlock(int difficulty) {
-    std::string target(difficulty, '0');
-    do {
-        nonce++;
-        hash = calculateHash();
-    } while (hash.substr(0, difficulty) != target);
+bool Block::isValid(int difficulty) const {
+    // Header-only blocks cannot be checked against their transactions
+    if (isHeaderOnly()) return false;
+
+    if (hash != calculateHash()) return false;
+
+    // The genesis block is never mined
+    if (index > 0 && hash.leadingZeroBits() < difficulty * 4) return false;
+
+    // Scratch for the rebuild is released in one go when the check returns
+    BlockArena scratch(transactions.size());
+    std::pmr::vector<Hash256> txHashes = calculateTransactionHashes(scratch.get());
+    if (merkleRoot != MerkleTree::computeMerkleRoot(txHashes.data(), txHashes.size(), scratch.get())) return false;
+
+    // Regular transactions must be valid; at most one mining reward (no sender) per block
+    size_t rewards = 0;
+    for (const auto& tx : transactions) {
+        if (tx.isReward()) {
+            if (tx.getReceiver().isZero() || tx.getAmount() <= 0 || ++rewards > 1) return false;
+        } else if (!tx.isValid()) {
+            return false;
+        }
+    }
+    return true;
 }
 
-std::string Block::getHash() const {
+const Hash256& Block::getHash() const {
     return hash;
 }
 
-std::string Block::getPreviousHash() const {
+const Hash256& Block::getPreviousHash() const {
     return previousHash;
 }
 
-std::vector<Transaction> Block::getTransactions() const {
+const Hash256& Block::getMerkleRoot() const {
+    return merkleRoot;
+}
+
+MerkleProof Block::getMerkleProof(size_t txIndex) const {
+    BlockArena scratch(transactions.size());
+    std::pmr::vector<Hash256> txHashes = calculateTransactionHashes(scratch.get());
+    return MerkleTree(txHashes.data(), txHashes.size(), scratch.get()).getProof(txIndex);
+}
+
+const TransactionColumns& Block::getTransactions() const {
     return transactions;
 }
 
+size_t Block::getTransactionCount() const {
+    return transactionCount;
+}
+
+bool Block::isHeaderOnly() const {
+    return transactions.size() != transactionCount;
+}
+
+BlockHeader Block::getHeader() const {
+    return BlockHeader(index, timestamp, previousHash, merkleRoot, nonce);
+}
+
 long long Block::getTimestamp() const {
     return timestamp;
 }
@@ -58,3 +222,7 @@ long long Block::getTimestamp() const {
 int Block::getIndex() const {
     return index;
 }
+
+int Block::getNonce() const {
+    return nonce;
+}
@@ -0,0 +1,24 @@
+// src/BlockArena.cpp
+#include "BlockArena.h"
+#include "Transaction.h"
+
+BlockArena::BlockArena(std::size_t transactionCount)
+    : resource(estimateBytes(transactionCount))
+{
+}
+
+std::pmr::memory_resource* BlockArena::get() {
+    return &resource;
+}
+
+std::size_t BlockArena::estimateBytes(std::size_t transactionCount) {
+    std::size_t leaves = 1;
+    while (leaves < transactionCount) leaves <<= 1;
+
+    // Columns, then the batch hashing inputs (serialized rows, pointers, lengths, digests)
+    std::size_t columns = transactionCount * (Transaction::SERIALIZED_SIZE + SIGNATURE_SIZE);
+    std::size_t hashing = transactionCount * (Transaction::SERIALIZED_SIZE + 2 * sizeof(std::size_t) + Hash256::SIZE);
+    // Merkle levels (2 * leaves nodes) plus one level of pair scratch
+    std::size_t merkle = 2 * leaves * Hash256::SIZE + leaves * (Hash256::SIZE + 2 * sizeof(std::size_t));
+    return columns + hashing + merkle + 4096;
+}
@@ -0,0 +1,72 @@
+// src/BlockHeader.cpp
+#include "BlockHeader.h"
+#include <cstring>
+
+namespace {
+    void writeLE(unsigned char* out, std::uint64_t value, std::size_t width) {
+        for (std::size_t i = 0; i < width; ++i) {
+            out[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    std::uint64_t readLE(const unsigned char* in, std::size_t width) {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < width; ++i) {
+            value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+}
+
+BlockHeader::BlockHeader(int index, long long timestamp, const Hash256& previousHash,
+                         const Hash256& merkleRoot, int nonce) {
+    writeLE(bytes, static_cast<std::uint32_t>(index), 4);
+    writeLE(bytes + 4, static_cast<std::uint64_t>(timestamp), 8);
+    std::memcpy(bytes + 12, previousHash.data(), Hash256::SIZE);
+    std::memcpy(bytes + 44, merkleRoot.data(), Hash256::SIZE);
+    setNonce(nonce);
+}
+
+BlockHeader BlockHeader::fromBytes(const unsigned char* data) {
+    BlockHeader header;
+    std::memcpy(header.bytes, data, SIZE);
+    return header;
+}
+
+int BlockHeader::getIndex() const {
+    return static_cast<int>(static_cast<std::uint32_t>(readLE(bytes, 4)));
+}
+
+long long BlockHeader::getTimestamp() const {
+    return static_cast<long long>(readLE(bytes + 4, 8));
+}
+
+Hash256 BlockHeader::getPreviousHash() const {
+    Hash256 hash;
+    std::memcpy(hash.data(), bytes + 12, Hash256::SIZE);
+    return hash;
+}
+
+Hash256 BlockHeader::getMerkleRoot() const {
+    Hash256 hash;
+    std::memcpy(hash.data(), bytes + 44, Hash256::SIZE);
+    return hash;
+}
+
+int BlockHeader::getNonce() const {
+    return static_cast<int>(static_cast<std::uint32_t>(readLE(bytes + NONCE_OFFSET, 4)));
+}
+
+void BlockHeader::setNonce(int nonce) {
+    writeLE(bytes + NONCE_OFFSET, static_cast<std::uint32_t>(nonce), 4);
+}
+
+HeaderHasher::HeaderHasher(const BlockHeader& header) {
+    midstate.update(header.bytes, 64);
+    midstate.padFinalBlock(header.bytes + 64, BlockHeader::SIZE - 64, finalBlock);
+}
+
+void HeaderHasher::hash(int nonce, Hash256& digest) {
+    writeLE(finalBlock + (BlockHeader::NONCE_OFFSET - 64), static_cast<std::uint32_t>(nonce), 4);
+    midstate.finalizeBlock(finalBlock, digest);
+}
@@ -1,117 +1,728 @@
 // src/Blockchain.cpp
 #include "Blockchain.h"
+#include "BlockArena.h"
+#include "SignatureVerifier.h"
+#include "metrics/ChainMetrics.h"
 #include "utils/Timestamp.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
-Blockchain::Blockchain(const std::string& genesisAddress) {
+namespace {
+    std::atomic<std::uint64_t> nextInstanceId{1};
+
+    // Fixed so independently started nodes agree on the genesis hash
+    const long long GENESIS_TIMESTAMP = 1700000000;
+}
+
+Blockchain::Blockchain(const Hash256& genesisAddress)
+    : publishedVersion(0), instanceId(nextInstanceId++)
+{
     difficulty = 2; // Start with low difficulty
-    miningReward = 100.0; // Mining reward amount
+    miningReward = 100 * COIN; // Mining reward amount
+    miningThreads = 1; // Single-threaded proof-of-work by default
+    enforceBalances = false;
+    verifySignatures = false;
+    mempool = std::make_shared<Mempool>();
+    validatedHeight = 0;
+    validationThreads = 0; // One validation worker per hardware thread
+    snapshotInterval = 1000; // State snapshot every 1000 blocks once a store is attached
     
     // Create genesis block
     chain.push_back(createGenesisBlock());
+    index.addBlock(chain.back());
+    indexedHeight = 1;
+    publish(std::make_shared<const ChainSnapshot>(0, chain.size(), std::make_shared<const Block>(chain.back()),
+                                                  BalanceTable()));
+}
+
+Blockchain::Blockchain(const Hash256& genesisAddress, const std::string& dataDirectory,
+                       const BlockStoreOptions& options)
+    : Blockchain(genesisAddress)
+{
+    store = std::make_unique<BlockStore>(dataDirectory, options);
+    stateSnapshots = std::make_unique<StateSnapshotStore>(dataDirectory);
+
+    if (store->size() == 0) {
+        // Fresh store: persist the genesis block created above
+        store->append(chain.front());
+        store->setDifficulty(difficulty);
+        return;
+    }
+    if (store->getDifficulty() >= 0) difficulty = store->getDifficulty();
+
+    // Reopen: keep only headers resident, with the hashes the store already recorded
+    chain.clear();
+    chain.reserve(store->size());
+    for (size_t height = 0; height < store->size(); height++) {
+        chain.emplace_back(store->getHeader(height), store->getHash(height), store->getTransactionCount(height));
+    }
+
+    // Start from the newest snapshot that still matches the stored chain and replay
+    // only the blocks after it. Nothing else holds the table yet, so it is updated in
+    // place rather than copied.
+    StateSnapshot saved;
+    size_t replayFrom = 0;
+    bool loaded = stateSnapshots->loadLatest([this](size_t blockCount, const Hash256& tipHash) {
+        return blockCount > 0 && blockCount <= store->size() && store->getHash(blockCount - 1) == tipHash;
+    }, saved);
+    if (loaded) replayFrom = saved.blockCount;
+    BalanceTable balances = std::move(saved.balances);
+    for (size_t height = replayFrom; height < store->size(); height++) {
+        if (!balances.applyBlock(store->readBlock(height).getTransactions())) {
+            throw std::runtime_error("Blockchain: stored block " + std::to_string(height) + " overflows a balance");
+        }
+    }
+
+    index.clear();
+    indexedHeight = 0;
+
+    auto tip = std::make_shared<const Block>(store->readBlock(store->size() - 1));
+    publish(std::make_shared<const ChainSnapshot>(0, chain.size(), std::move(tip), std::move(balances)));
+
+    // The transaction and address index is rebuilt off the reopen and commit paths, into a
+    // table of its own so lookups and appends are not held behind indexMutex meanwhile.
+    // A failed read leaves indexedHeight at 0 and catchUpIndex retries, throwing to its caller.
+    size_t count = chain.size();
+    indexBuild = std::async(std::launch::async, [this, count] {
+        ChainIndex rebuilt;
+        for (size_t height = 0; height < count; height++) {
+            rebuilt.addBlock(getBlock(height));
+        }
+        std::unique_lock<std::shared_mutex> lock(indexMutex);
+        index = std::move(rebuilt);
+        indexedHeight = count;
+    }).share();
 }
 
 Block Blockchain::createGenesisBlock() {
     std::vector<Transaction> genesisTransactions;
     // Genesis block has no transactions
-    return Block(0, genesisTransactions, "0");
+    return Block(0, genesisTransactions, Hash256{}, GENESIS_TIMESTAMP);
 }
 
-void Blockchain::addTransaction(const Transaction& transaction) {
-    pendingTransactions.push_back(transaction);
+bool Blockchain::addTransaction(const Transaction& transaction) {
+    ChainMetrics& metrics = ChainMetrics::get();
+    // One confirmed in between is caught by the ledger rules and dropped when a template repeats it
+    TransactionLocation location;
+    if (findTransaction(transaction.getId(), location)) {
+        metrics.recordAdmission(AdmitResult::Duplicate);
+        return false;
+    }
+    if (verifySignatures && !SignatureVerifier::shared().verify(transaction.getSender(), transaction.serialize(), transaction.getSignature())) {
+        metrics.signatureRejected.inc();
+        return false;
+    }
+
+    Amount spendLimit = enforceBalances ? getBalanceOfAddress(transaction.getSender())
+                                        : std::numeric_limits<Amount>::max();
+    std::shared_ptr<Mempool> pool = currentMempool();
+    AdmitResult result = pool->add(transaction, spendLimit);
+    metrics.recordAdmission(result);
+    metrics.mempoolDepth.set(static_cast<double>(pool->size()));
+    return result == AdmitResult::Accepted;
 }
 
-void Blockchain::minePendingTransactions(const std::string& miningRewardAddress) {
-    // Add mining reward transaction
-    Transaction rewardTransaction("", miningRewardAddress, miningReward);
-    pendingTransactions.push_back(rewardTransaction);
+size_t Blockchain::addTransactions(const std::vector<Transaction>& transactions) {
+    std::vector<bool> signaturesValid(transactions.size(), true);
+    if (verifySignatures) {
+        std::vector<SignatureCheck> checks;
+        checks.reserve(transactions.size());
+        for (const auto& tx : transactions) {
+            checks.push_back({tx.getSender(), tx.serialize(), tx.getSignature()});
+        }
+        signaturesValid = SignatureVerifier::shared().verifyBatch(checks);
+    }
+
+    ChainMetrics& metrics = ChainMetrics::get();
+    std::shared_ptr<Mempool> pool = currentMempool();
+    size_t accepted = 0;
+    TransactionLocation location;
+    for (size_t i = 0; i < transactions.size(); i++) {
+        if (findTransaction(transactions[i].getId(), location)) {
+            metrics.recordAdmission(AdmitResult::Duplicate);
+            continue;
+        }
+        if (!signaturesValid[i]) {
+            metrics.signatureRejected.inc();
+            continue;
+        }
+        Amount spendLimit = enforceBalances ? getBalanceOfAddress(transactions[i].getSender())
+                                            : std::numeric_limits<Amount>::max();
+        AdmitResult result = pool->add(transactions[i], spendLimit);
+        metrics.recordAdmission(result);
+        if (result == AdmitResult::Accepted) {
+            accepted++;
+        }
+    }
+    metrics.mempoolDepth.set(static_cast<double>(pool->size()));
+    return accepted;
+}
+
+void Blockchain::minePendingTransactions(const Hash256& miningRewardAddress) {
+    auto buildStart = std::chrono::steady_clock::now();
+
+    // Build the block template from the mempool, mining reward last
+    std::vector<Transaction> blockTransactions = selectBlockTransactions(miningRewardAddress);
     
-    // Create new block with pending transactions
-    Block newBlock(chain.size(), pendingTransactions, getLatestBlock().getHash());
-    newBlock.mineBlock(difficulty);
+    // Create new block with pending transactions; its assembly scratch lives in one
+    // arena that is dropped once the block has been copied into the chain or store
+    BlockArena arena(blockTransactions.size());
+    Block newBlock = createBlockTemplate(blockTransactions, arena.get());
+    auto sealStart = std::chrono::steady_clock::now();
+    MiningStats stats = newBlock.mineBlock(difficulty, miningThreads);
+    auto sealEnd = std::chrono::steady_clock::now();
     
-    std::cout << "Block successfully mined: " << newBlock.getHash() << std::endl;
+    std::cout << "Block successfully mined: " << newBlock.getHash().toHex() << std::endl;
+    std::cout << "Mining stats: " << stats.attempts << " hashes in " << stats.elapsedSeconds
+              << "s (" << static_cast<long long>(stats.hashRate()) << " H/s";
+    if (stats.threads > 1) {
+        std::cout << "; per thread:";
+        for (double rate : stats.threadHashRates) {
+            std::cout << " " << static_cast<long long>(rate);
+        }
+    }
+    std::cout << ")" << std::endl;
     
-    // Add block to chain and clear pending transactions
-    chain.push_back(newBlock);
-    pendingTransactions.clear();
+    // Add block to chain, fold its transactions into the balance table and drop them from the mempool
+    switch (commitBlock(newBlock, blockTransactions)) {
+        case CommitResult::Committed:
+            break;
+        case CommitResult::Stale:
+            std::cout << "Block discarded: a background miner extended the chain first" << std::endl;
+            return;
+        case CommitResult::InvalidReward:
+            std::cout << "Block discarded: its reward does not match the subsidy plus fees" << std::endl;
+            return;
+        case CommitResult::ConfirmedTransaction:
+            std::cout << "Block discarded: it repeats a confirmed transaction, now dropped from the mempool" << std::endl;
+            return;
+        case CommitResult::Overspend:
+            std::cout << "Block discarded: a sender overspends its balance; the transaction left the mempool" << std::endl;
+            return;
+        case CommitResult::BalanceOverflow:
+            std::cout << "Block discarded: a balance would overflow" << std::endl;
+            return;
+    }
+
+    ChainMetrics& metrics = ChainMetrics::get();
+    metrics.blocksMined.inc();
+    metrics.blockBuildSeconds.observe(std::chrono::duration<double>(sealStart - buildStart).count());
+    metrics.blockSealSeconds.observe(std::chrono::duration<double>(sealEnd - sealStart).count());
+    metrics.blockTransactions.observe(static_cast<double>(blockTransactions.size()));
 }
 
-double Blockchain::getBalanceOfAddress(const std::string& address) const {
-    double balance = 0.0;
-    
-    // Go through all blocks and transactions
-    for (const auto& block : chain) {
-        for (const auto& transaction : block.getTransactions()) {
-            // If address is sender, subtract amount
-            if (transaction.getSender() == address) {
-                balance -= transaction.getAmount();
+std::vector<Transaction> Blockchain::selectBlockTransactions(const Hash256& miningRewardAddress) const {
+    std::vector<Transaction> blockTransactions = currentMempool()->selectForBlock();
+    // Transactions whose fees would overflow the reward wait for a later block; dropping
+    // a suffix keeps each sender's order
+    Amount reward = miningReward;
+    for (size_t i = 0; i < blockTransactions.size(); i++) {
+        if (!checkedAdd(reward, blockTransactions[i].getFee(), reward)) {
+            blockTransactions.erase(blockTransactions.begin() + i, blockTransactions.end());
+            break;
+        }
+    }
+
+    // Add mining reward transaction
+    blockTransactions.emplace_back(Hash256{}, miningRewardAddress, reward);
+    return blockTransactions;
+}
+
+Block Blockchain::createBlockTemplate(const std::vector<Transaction>& transactions,
+                                      std::pmr::memory_resource* resource) const {
+    std::shared_ptr<const ChainSnapshot> current = getSnapshot();
+    return Block(static_cast<int>(current->getBlockCount()), transactions, current->getLatestBlock().getHash(),
+                 Timestamp::getCurrentEpochSeconds(), resource);
+}
+
+bool Blockchain::submitBlock(const Block& block) {
+    // Stale blocks are common under competing miners; reject those before the full check
+    if (static_cast<size_t>(block.getIndex()) != getBlockCount()) return false;
+    if (!block.isValid(difficulty)) return false;
+    if (verifySignatures && !hasValidSignatures(block)) return false;
+
+    std::vector<Transaction> transactions(block.getTransactions().begin(), block.getTransactions().end());
+    return commitBlock(block, transactions) == CommitResult::Committed;
+}
+
+Blockchain::CommitResult Blockchain::commitBlock(const Block& block, const std::vector<Transaction>& transactions) {
+    {
+        std::lock_guard<std::mutex> writer(commitMutex);
+        std::shared_ptr<const ChainSnapshot> previous = getSnapshot();
+        if (static_cast<size_t>(block.getIndex()) != previous->getBlockCount() ||
+            block.getPreviousHash() != previous->getLatestBlock().getHash()) {
+            return CommitResult::Stale;
+        }
+
+        // Sealed blocks from other miners and peers get the same rules as the local template
+        BlockArena scratch(block.getTransactionCount());
+        std::pmr::vector<Hash256> ids = block.calculateTransactionHashes(scratch.get());
+        if (!hasValidReward(block)) return CommitResult::InvalidReward;
+        std::vector<Transaction> offending;
+        CommitResult rules = checkLedgerRules(block, *previous, ids.data(), offending);
+        if (rules != CommitResult::Committed) {
+            // Left pending, they would go into every later template and be refused again
+            currentMempool()->removeConfirmed(offending);
+            return rules;
+        }
+
+        // Next state is prepared beside the published one; readers keep using the old
+        // snapshot meanwhile and the exclusive section below only pushes the block
+        BalanceTable balances = previous->getBalances();
+        if (!balances.applyBlock(block.getTransactions())) return CommitResult::BalanceOverflow;
+        auto tip = std::make_shared<const Block>(block);
+        {
+            std::unique_lock<std::shared_mutex> lock(stateMutex);
+            if (store) {
+                store->append(block);
+                chain.emplace_back(block.getHeader(), block.getHash(), block.getTransactionCount());
+            } else {
+                chain.push_back(block);
             }
-            
-            // If address is receiver, add amount
-            if (transaction.getReceiver() == address) {
-                balance += transaction.getAmount();
+        }
+
+        // Cleared before the new tip is visible, so no template built on it can pick up
+        // a transaction this block already confirmed
+        currentMempool()->removeConfirmed(transactions);
+        auto next = std::make_shared<const ChainSnapshot>(previous->getVersion() + 1, previous->getBlockCount() + 1,
+                                                          std::move(tip), std::move(balances));
+        publish(next);
+
+        // A lagging index (after a reopen) picks this block up when it catches up
+        {
+            std::unique_lock<std::shared_mutex> lock(indexMutex);
+            if (indexedHeight == static_cast<size_t>(block.getIndex())) {
+                index.addBlock(block, ids.data());
+                indexedHeight++;
             }
         }
+
+        if (stateSnapshots && snapshotInterval > 0 && next->getBlockCount() % snapshotInterval == 0) {
+            writeStateSnapshot(std::move(next));
+        }
     }
-    
-    return balance;
+
+    ChainMetrics& metrics = ChainMetrics::get();
+    metrics.chainHeight.set(static_cast<double>(getBlockCount()));
+    metrics.mempoolDepth.set(static_cast<double>(currentMempool()->size()));
+    return CommitResult::Committed;
+}
+
+void Blockchain::writeStateSnapshot(std::shared_ptr<const ChainSnapshot> state) {
+    // The published snapshot is immutable, so it can be serialized off the commit path;
+    // a previous write still running is waited for rather than queued behind
+    if (snapshotWrite.valid()) snapshotWrite.wait();
+    StateSnapshotStore* target = stateSnapshots.get();
+    int currentDifficulty = difficulty;
+    snapshotWrite = std::async(std::launch::async, [target, state, currentDifficulty] {
+        StateSnapshot saved;
+        saved.blockCount = state->getBlockCount();
+        saved.tipHash = state->getLatestBlock().getHash();
+        saved.difficulty = currentDifficulty;
+        saved.balances = state->getBalances();
+        try {
+            target->write(saved);
+        } catch (const std::exception&) {
+            // A missed snapshot only lengthens the next reopen's replay
+        }
+    });
+}
+
+void Blockchain::catchUpIndex() const {
+    if (indexBuild.valid()) indexBuild.wait();
+    size_t target = getBlockCount();
+    {
+        std::shared_lock<std::shared_mutex> lock(indexMutex);
+        if (indexedHeight >= target) return;
+    }
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    while (indexedHeight < target) {
+        index.addBlock(getBlock(indexedHeight));
+        indexedHeight++;
+    }
+}
+
+void Blockchain::publish(std::shared_ptr<const ChainSnapshot> next) {
+    std::uint64_t version = next->getVersion();
+    std::atomic_store_explicit(&snapshot, std::move(next), std::memory_order_release);
+    publishedVersion.store(version, std::memory_order_release);
+}
+
+std::shared_ptr<const ChainSnapshot> Blockchain::getSnapshot() const {
+    return std::atomic_load_explicit(&snapshot, std::memory_order_acquire);
+}
+
+const ChainSnapshot& Blockchain::currentSnapshot() const {
+    // Each thread keeps the last snapshot it loaded and reloads only when a newer one
+    // is published, so steady-state reads share the version's cache line read-only
+    // instead of bouncing the snapshot's reference count between cores
+    struct Cached {
+        std::uint64_t owner = 0;
+        std::uint64_t version = 0;
+        std::shared_ptr<const ChainSnapshot> snapshot;
+    };
+    thread_local Cached cached;
+
+    if (cached.owner != instanceId || cached.version != publishedVersion.load(std::memory_order_acquire)) {
+        cached.snapshot = getSnapshot();
+        cached.owner = instanceId;
+        cached.version = cached.snapshot->getVersion();
+    }
+    return *cached.snapshot;
+}
+
+Amount Blockchain::getBalanceOfAddress(const Hash256& address) const {
+    return currentSnapshot().getBalanceOfAddress(address);
+}
+
+Amount Blockchain::getSpendableBalance(const Hash256& address) const {
+    return getBalanceOfAddress(address) - currentMempool()->getPendingSpend(address);
+}
+
+bool Blockchain::hasSufficientBalance(const Hash256& address, Amount amount) const {
+    return getSpendableBalance(address) >= amount;
 }
 
 bool Blockchain::isChainValid() const {
-    for (size_t i = 1; i < chain.size(); i++) {
-        const Block& currentBlock = chain[i];
-        const Block& previousBlock = chain[i - 1];
-        
-        // Check if current block's hash is valid
-        if (currentBlock.getHash() != currentBlock.calculateHash()) {
+    std::shared_lock<std::shared_mutex> lock(stateMutex);
+    size_t from = validatedHeight;
+    if (from >= chain.size()) return true;
+
+    auto start = std::chrono::steady_clock::now();
+    bool valid = validateFrom(from);
+
+    ChainMetrics& metrics = ChainMetrics::get();
+    metrics.validationSeconds.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    if (valid) {
+        metrics.blocksValidated.inc(chain.size() - from);
+    } else {
+        metrics.validationFailures.inc();
+    }
+    return valid;
+}
+
+bool Blockchain::validateFrom(size_t from) const {
+    // Check if each block points to the previous block (headers only, sequential)
+    for (size_t i = from > 0 ? from : 1; i < chain.size(); i++) {
+        if (chain[i].getIndex() != static_cast<int>(i) ||
+            chain[i].getPreviousHash() != chain[i - 1].getHash()) {
             return false;
         }
-        
-        // Check if current block points to previous block
-        if (currentBlock.getPreviousHash() != previousBlock.getHash()) {
-            return false;
+    }
+
+    // Hash, proof-of-work, Merkle root and transactions are independent per block
+    std::atomic<bool> valid{true};
+    getValidationPool().parallelFor(chain.size() - from, [&](size_t offset) {
+        if (!valid.load(std::memory_order_relaxed)) return;
+        size_t height = from + offset;
+        const Block& block = chain[height];
+        bool blockValid;
+        try {
+            if (store && block.isHeaderOnly()) {
+                Block loaded = store->readBlock(height);
+                blockValid = loaded.isValid(difficulty) && hasValidReward(loaded);
+            } else {
+                blockValid = block.isValid(difficulty) && hasValidReward(block);
+            }
+        } catch (const std::exception&) {
+            blockValid = false; // Unreadable or corrupt stored block
+        }
+        if (!blockValid) {
+            valid.store(false, std::memory_order_relaxed);
+        }
+    });
+
+    if (!valid) return false;
+
+    // Signatures are checked block by block so each block's batch spreads over the verifier's pool
+    if (verifySignatures) {
+        for (size_t height = from; height < chain.size(); height++) {
+            const Block& block = chain[height];
+            bool signaturesValid = (store && block.isHeaderOnly()) ? hasValidSignatures(store->readBlock(height))
+                                                           : hasValidSignatures(block);
+            if (!signaturesValid) return false;
         }
     }
-    
+
+    validatedHeight = chain.size();
     return true;
 }
 
+ThreadPool& Blockchain::getValidationPool() const {
+    std::lock_guard<std::mutex> lock(validationPoolMutex);
+    if (!validationPool) {
+        validationPool = std::make_unique<ThreadPool>(validationThreads);
+    }
+    return *validationPool;
+}
+
+bool Blockchain::hasValidSignatures(const Block& block) const {
+    std::vector<SignatureCheck> checks;
+    for (const auto& tx : block.getTransactions()) {
+        if (tx.isReward()) continue; // Mining rewards are unsigned
+        checks.push_back({tx.getSender(), tx.serialize(), tx.getSignature()});
+    }
+    for (bool valid : SignatureVerifier::shared().verifyBatch(checks)) {
+        if (!valid) return false;
+    }
+    return true;
+}
+
+bool Blockchain::hasValidReward(const Block& block) const {
+    if (block.getIndex() == 0) return true;  // Genesis mints nothing
+
+    const TransactionColumns& transactions = block.getTransactions();
+    Amount fees = 0;
+    Amount reward = 0;
+    size_t rewards = 0;
+    for (size_t i = 0; i < transactions.size(); i++) {
+        if (transactions.senders[i].isZero()) {
+            reward = transactions.amounts[i];
+            rewards++;
+        } else if (!checkedAdd(fees, transactions.fees[i], fees)) {
+            return false;
+        }
+    }
+    Amount expected;
+    return rewards == 1 && checkedAdd(miningReward, fees, expected) && reward == expected;
+}
+
+Blockchain::CommitResult Blockchain::checkLedgerRules(const Block& block, const ChainSnapshot& previous,
+                                                      const Hash256* ids, std::vector<Transaction>& offending) const {
+    const TransactionColumns& transactions = block.getTransactions();
+
+    // Rewards are exempt: two equal rewards within a second share an id
+    catchUpIndex();
+    {
+        std::unordered_set<Hash256> seen;
+        std::shared_lock<std::shared_mutex> lock(indexMutex);
+        TransactionLocation location;
+        for (size_t i = 0; i < transactions.size(); i++) {
+            if (transactions.senders[i].isZero()) continue;
+            if (!seen.insert(ids[i]).second || index.findTransaction(ids[i], location)) {
+                offending.push_back(transactions[i]);
+            }
+        }
+    }
+    if (!offending.empty()) return CommitResult::ConfirmedTransaction;
+
+    // Same limit the mempool applies on admission: a sender's spends in the block,
+    // amount + fee, against its confirmed balance before the block. Only each sender's
+    // first transaction over the limit offends; the ones after it may fit without it.
+    if (enforceBalances) {
+        std::unordered_map<Hash256, Amount> spends;
+        std::unordered_set<Hash256> overspent;
+        for (size_t i = 0; i < transactions.size(); i++) {
+            const Hash256& sender = transactions.senders[i];
+            if (sender.isZero() || overspent.count(sender)) continue;
+            Amount& spent = spends[sender];
+            if (!checkedAdd(spent, transactions.amounts[i], spent) || !checkedAdd(spent, transactions.fees[i], spent) ||
+                spent > previous.getBalanceOfAddress(sender)) {
+                overspent.insert(sender);
+                offending.push_back(transactions[i]);
+            }
+        }
+    }
+    return offending.empty() ? CommitResult::Committed : CommitResult::Overspend;
+}
+
+bool Blockchain::revalidateChain() const {
+    validatedHeight = 0;
+    return isChainValid();
+}
+
 void Blockchain::printChain() const {
     for (size_t i = 0; i < chain.size(); i++) {
-        const Block& block = chain[i];
+        // Resident blocks are printed in place; only store-backed ones are read back
+        std::optional<Block> loaded;
+        if (chain[i].isHeaderOnly()) loaded.emplace(getBlock(i));
+        const Block& block = loaded ? *loaded : chain[i];
+        const TransactionColumns& transactions = block.getTransactions();
         std::cout << "\n=== Block " << i << " ===\n";
-        std::cout << "Hash: " << block.getHash() << "\n";
-        std::cout << "Previous Hash: " << block.getPreviousHash() << "\n";
+        std::cout << "Hash: " << block.getHash().toHex() << "\n";
+        std::cout << "Previous Hash: " << block.getPreviousHash().toHex() << "\n";
         std::cout << "Timestamp: " << block.getTimestamp() << "\n";
-        std::cout << "Transactions: " << block.getTransactions().size() << "\n";
+        std::cout << "Transactions: " << transactions.size() << "\n";
         
         // Print transaction details
-        for (size_t j = 0; j < block.getTransactions().size(); j++) {
-            const Transaction& tx = block.getTransactions()[j];
+        for (size_t j = 0; j < transactions.size(); j++) {
+            const Transaction tx = transactions[j];
             std::cout << "  Transaction " << j + 1 << ": ";
-            if (tx.getSender().empty()) {
-                std::cout << "Mining Reward -> " << tx.getReceiver() << " (" << tx.getAmount() << ")\n";
+            if (tx.isReward()) {
+                std::cout << "Mining Reward -> " << tx.getReceiver().toHex() << " (" << formatAmount(tx.getAmount()) << ")\n";
             } else {
-                std::cout << tx.getSender() << " -> " << tx.getReceiver() << " (" << tx.getAmount() << ")\n";
+                std::cout << tx.getSender().toHex() << " -> " << tx.getReceiver().toHex() << " (" << formatAmount(tx.getAmount()) << ")\n";
             }
         }
     }
 }
 
-Block Blockchain::getLatestBlock() const {
+Block Blockchain::getBlock(size_t height) const {
+    std::shared_lock<std::shared_mutex> lock(stateMutex);
+    const Block& block = chain.at(height);
+    if (store && block.isHeaderOnly()) {
+        return store->readBlock(height);
+    }
+    return block;
+}
+
+const Block& Blockchain::getLatestBlock() const {
     return chain.back();
 }
 
-std::vector<Block> Blockchain::getChain() const {
+const std::vector<Block>& Blockchain::getChain() const {
     return chain;
 }
 
+size_t Blockchain::getBlockCount() const {
+    return currentSnapshot().getBlockCount();
+}
+
+BlockRange Blockchain::getBlocks() const {
+    return BlockRange(chain);
+}
+
+BlockRange Blockchain::getBlocks(size_t fromHeight, size_t toHeight) const {
+    if (fromHeight > toHeight) {
+        throw std::out_of_range("Blockchain::getBlocks: fromHeight after toHeight");
+    }
+    return BlockRange(chain).subspan(fromHeight, toHeight - fromHeight);
+}
+
+TransactionRange Blockchain::getTransactions() const {
+    return TransactionRange(this, 0, chain.size());
+}
+
+TransactionRange Blockchain::getTransactions(size_t fromHeight, size_t toHeight) const {
+    if (fromHeight > toHeight || toHeight > chain.size()) {
+        throw std::out_of_range("Blockchain::getTransactions: height range outside chain");
+    }
+    return TransactionRange(this, fromHeight, toHeight);
+}
+
+bool Blockchain::findBlockHeight(const Hash256& hash, size_t& height) const {
+    catchUpIndex();
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+    return index.findBlock(hash, height);
+}
+
+bool Blockchain::findTransaction(const Hash256& id, TransactionLocation& location) const {
+    catchUpIndex();
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+    return index.findTransaction(id, location);
+}
+
+Transaction Blockchain::getTransaction(const TransactionLocation& location) const {
+    std::shared_lock<std::shared_mutex> lock(stateMutex);
+    const Block& block = chain.at(location.height);
+    if (store && block.isHeaderOnly()) {
+        return store->readTransaction(location.height, location.position);
+    }
+    if (location.position >= block.getTransactions().size()) {
+        throw std::out_of_range("Blockchain::getTransaction: position past the block's transactions");
+    }
+    return block.getTransactions()[location.position];
+}
+
+std::vector<TransactionLocation> Blockchain::getAddressHistory(const Hash256& address, size_t offset, size_t limit) const {
+    catchUpIndex();
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+    const std::vector<TransactionLocation>& history = index.getHistory(address);
+    if (offset >= history.size()) return {};
+    size_t count = std::min(limit, history.size() - offset);
+    return std::vector<TransactionLocation>(history.begin() + offset, history.begin() + offset + count);
+}
+
+std::vector<BlockHeader> Blockchain::getHeaders(size_t fromHeight, size_t toHeight) const {
+    std::shared_lock<std::shared_mutex> lock(stateMutex);
+    toHeight = std::min(toHeight, chain.size());
+    std::vector<BlockHeader> headers;
+    if (fromHeight >= toHeight) return headers;
+    headers.reserve(toHeight - fromHeight);
+    for (size_t height = fromHeight; height < toHeight; height++) {
+        headers.push_back(chain[height].getHeader());
+    }
+    return headers;
+}
+
+bool Blockchain::getTransactionProof(const Hash256& id, TransactionLocation& location, MerkleProof& proof) const {
+    if (!findTransaction(id, location)) return false;
+    proof = getBlock(location.height).getMerkleProof(location.position);
+    return true;
+}
+
 int Blockchain::getDifficulty() const {
     return difficulty;
 }
 
+void Blockchain::setDifficulty(int difficulty) {
+    this->difficulty = difficulty;
+    if (store) {
+        std::unique_lock<std::shared_mutex> lock(stateMutex);
+        store->setDifficulty(difficulty);
+    }
+}
+
+void Blockchain::setSignatureVerification(bool enabled) {
+    verifySignatures = enabled;
+}
+
+Hash256 Blockchain::registerPublicKey(const std::string& publicKeyPem) {
+    return SignatureVerifier::shared().registerPublicKey(publicKeyPem);
+}
+
+void Blockchain::setMempoolOptions(const MempoolOptions& options) {
+    auto replacement = std::make_shared<Mempool>(options);
+    for (const auto& tx : currentMempool()->snapshot()) {
+        replacement->add(tx);
+    }
+    std::atomic_store_explicit(&mempool, std::move(replacement), std::memory_order_release);
+}
+
+std::shared_ptr<Mempool> Blockchain::currentMempool() const {
+    return std::atomic_load_explicit(&mempool, std::memory_order_acquire);
+}
+
+std::shared_ptr<const Mempool> Blockchain::getMempool() const {
+    return currentMempool();
+}
+
+void Blockchain::setStateSnapshotInterval(unsigned int blocks) {
+    snapshotInterval = blocks;
+}
+
+void Blockchain::setValidationThreads(unsigned int threads) {
+    // Validations hold stateMutex shared for as long as they use the pool
+    std::unique_lock<std::shared_mutex> lock(stateMutex);
+    validationThreads = threads;
+    validationPool.reset();
+}
+
+void Blockchain::setBalanceEnforcement(bool enabled) {
+    enforceBalances = enabled;
+}
+
+unsigned int Blockchain::getMiningThreads() const {
+    return miningThreads;
+}
+
+void Blockchain::setMiningThreads(unsigned int threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    miningThreads = threads > 0 ? threads : 1;
+}
+
 std::vector<Transaction> Blockchain::getPendingTransactions() const {
-    return pendingTransactions;
+    return currentMempool()->snapshot();
 }
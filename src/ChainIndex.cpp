@@ -0,0 +1,54 @@
+// src/ChainIndex.cpp
+#include "ChainIndex.h"
+#include "BlockArena.h"
+
+void ChainIndex::addBlock(const Block& block) {
+    BlockArena scratch(block.getTransactionCount());
+    std::pmr::vector<Hash256> ids = block.calculateTransactionHashes(scratch.get());
+    addBlock(block, ids.data());
+}
+
+void ChainIndex::addBlock(const Block& block, const Hash256* ids) {
+    const std::uint32_t height = static_cast<std::uint32_t>(block.getIndex());
+    heightByHash[block.getHash()] = height;
+
+    const TransactionColumns& transactions = block.getTransactions();
+    locationById.reserve(locationById.size() + transactions.size());
+
+    for (size_t i = 0; i < transactions.size(); i++) {
+        TransactionLocation location{height, static_cast<std::uint32_t>(i)};
+        locationById.emplace(ids[i], location);
+
+        // Rewards have no sender; a self-transfer is listed once
+        const Hash256& sender = transactions.senders[i];
+        const Hash256& receiver = transactions.receivers[i];
+        if (!sender.isZero()) historyByAddress[sender].push_back(location);
+        if (receiver != sender) historyByAddress[receiver].push_back(location);
+    }
+}
+
+void ChainIndex::clear() {
+    heightByHash.clear();
+    locationById.clear();
+    historyByAddress.clear();
+}
+
+bool ChainIndex::findBlock(const Hash256& hash, std::size_t& height) const {
+    auto it = heightByHash.find(hash);
+    if (it == heightByHash.end()) return false;
+    height = it->second;
+    return true;
+}
+
+bool ChainIndex::findTransaction(const Hash256& id, TransactionLocation& location) const {
+    auto it = locationById.find(id);
+    if (it == locationById.end()) return false;
+    location = it->second;
+    return true;
+}
+
+const std::vector<TransactionLocation>& ChainIndex::getHistory(const Hash256& address) const {
+    static const std::vector<TransactionLocation> empty;
+    auto it = historyByAddress.find(address);
+    return it != historyByAddress.end() ? it->second : empty;
+}
@@ -0,0 +1,26 @@
+// src/ChainSnapshot.cpp
+#include "ChainSnapshot.h"
+
+ChainSnapshot::ChainSnapshot(std::uint64_t version, std::size_t blockCount, std::shared_ptr<const Block> tip,
+                             BalanceTable balances)
+    : version(version), blockCount(blockCount), tip(std::move(tip)), balances(std::move(balances)) {}
+
+std::uint64_t ChainSnapshot::getVersion() const {
+    return version;
+}
+
+std::size_t ChainSnapshot::getBlockCount() const {
+    return blockCount;
+}
+
+const Block& ChainSnapshot::getLatestBlock() const {
+    return *tip;
+}
+
+Amount ChainSnapshot::getBalanceOfAddress(const Hash256& address) const {
+    return balances.get(address);
+}
+
+const BalanceTable& ChainSnapshot::getBalances() const {
+    return balances;
+}
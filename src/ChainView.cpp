@@ -0,0 +1,84 @@
+// src/ChainView.cpp
+#include "ChainView.h"
+#include "Blockchain.h"
+
+TransactionIterator::TransactionIterator(const Blockchain* chain, std::size_t height, std::size_t endHeight)
+    : chain(chain), blockHeight(height), endHeight(endHeight), position(0), current(nullptr) {
+    settle();
+}
+
+void TransactionIterator::settle() {
+    while (blockHeight < endHeight) {
+        if (!current) {
+            const Block& resident = chain->getBlocks()[blockHeight];
+            if (resident.isHeaderOnly()) {
+                loaded = std::make_shared<const Block>(chain->getBlock(blockHeight));
+                current = loaded.get();
+            } else {
+                loaded.reset();
+                current = &resident;
+            }
+        }
+        if (position < current->getTransactions().size()) {
+            row = current->getTransactions()[position];
+            return;
+        }
+
+        blockHeight++;
+        position = 0;
+        current = nullptr;
+    }
+    loaded.reset();
+    row.reset();
+}
+
+TransactionIterator::reference TransactionIterator::operator*() const {
+    return *row;
+}
+
+TransactionIterator::pointer TransactionIterator::operator->() const {
+    return &*row;
+}
+
+TransactionIterator& TransactionIterator::operator++() {
+    position++;
+    settle();
+    return *this;
+}
+
+TransactionIterator TransactionIterator::operator++(int) {
+    TransactionIterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+bool TransactionIterator::operator==(const TransactionIterator& other) const {
+    return blockHeight == other.blockHeight && position == other.position;
+}
+
+bool TransactionIterator::operator!=(const TransactionIterator& other) const {
+    return !(*this == other);
+}
+
+std::size_t TransactionIterator::height() const {
+    return blockHeight;
+}
+
+std::size_t TransactionIterator::index() const {
+    return position;
+}
+
+const Block& TransactionIterator::block() const {
+    return *current;
+}
+
+TransactionRange::TransactionRange(const Blockchain* chain, std::size_t from, std::size_t to)
+    : chain(chain), fromHeight(from), toHeight(to) {}
+
+TransactionIterator TransactionRange::begin() const {
+    return TransactionIterator(chain, fromHeight, toHeight);
+}
+
+TransactionIterator TransactionRange::end() const {
+    return TransactionIterator(chain, toHeight, toHeight);
+}
@@ -0,0 +1,72 @@
+// src/KeyPool.cpp
+#include "KeyPool.h"
+#include <stdexcept>
+
+KeyPool::KeyPool(KeyAlgorithm algorithm, std::size_t targetSize)
+    : algorithm(algorithm), targetSize(targetSize == 0 ? 1 : targetSize), stopping(false), failed(false) {
+    worker = std::thread([this] { workerLoop(); });
+}
+
+KeyPool::~KeyPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    refill.notify_all();
+    worker.join();
+    for (EVP_PKEY* key : keys) EVP_PKEY_free(key);
+}
+
+void KeyPool::workerLoop() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            refill.wait(lock, [this] { return stopping || (!failed && keys.size() < targetSize); });
+            if (stopping) return;
+        }
+
+        // Keygen runs outside the lock. An exception must not escape this thread; take()
+        // generates inline once the pool drains and reports the error to its caller.
+        EVP_PKEY* key;
+        try {
+            key = Wallet::generateKey(algorithm);
+        } catch (const std::exception&) {
+            std::lock_guard<std::mutex> lock(mutex);
+            failed = true;
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            EVP_PKEY_free(key);
+            return;
+        }
+        keys.push_back(key);
+    }
+}
+
+EVP_PKEY* KeyPool::take() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failed) {
+            failed = false;  // Let the worker try again
+            refill.notify_one();
+        }
+        if (!keys.empty()) {
+            EVP_PKEY* key = keys.front();
+            keys.pop_front();
+            refill.notify_one();
+            return key;
+        }
+    }
+    return Wallet::generateKey(algorithm);
+}
+
+std::size_t KeyPool::available() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return keys.size();
+}
+
+KeyAlgorithm KeyPool::getAlgorithm() const {
+    return algorithm;
+}
@@ -0,0 +1,69 @@
+// src/LightClient.cpp
+#include "LightClient.h"
+#include "utils/Hashing.h"
+#include <stdexcept>
+
+LightClient::LightClient(const BlockHeader& checkpoint, int difficulty)
+    : startHeight(static_cast<std::size_t>(checkpoint.getIndex())),
+      tipHash(Hashing::sha256(checkpoint.bytes, BlockHeader::SIZE)), difficulty(difficulty)
+{
+    headers.push_back(checkpoint);
+}
+
+bool LightClient::addHeader(const BlockHeader& header) {
+    if (header.getIndex() != static_cast<int>(getBlockCount())) return false;
+    if (header.getPreviousHash() != tipHash) return false;
+
+    Hash256 hash = Hashing::sha256(header.bytes, BlockHeader::SIZE);
+    if (hash.leadingZeroBits() < difficulty * 4) return false;
+
+    headers.push_back(header);
+    tipHash = hash;
+    return true;
+}
+
+std::size_t LightClient::addHeaders(const std::vector<BlockHeader>& batch) {
+    std::size_t added = 0;
+    for (const auto& header : batch) {
+        if (!addHeader(header)) break;
+        ++added;
+    }
+    return added;
+}
+
+std::size_t LightClient::getStartHeight() const {
+    return startHeight;
+}
+
+std::size_t LightClient::getBlockCount() const {
+    return startHeight + headers.size();
+}
+
+const BlockHeader& LightClient::getHeader(std::size_t height) const {
+    if (height < startHeight) {
+        throw std::out_of_range("LightClient::getHeader: height below the checkpoint");
+    }
+    return headers.at(height - startHeight);
+}
+
+const Hash256& LightClient::getTipHash() const {
+    return tipHash;
+}
+
+std::size_t LightClient::getConfirmations(std::size_t height) const {
+    if (height < startHeight || height >= getBlockCount()) return 0;
+    return getBlockCount() - height;
+}
+
+std::size_t LightClient::getMemoryUsage() const {
+    return headers.capacity() * sizeof(BlockHeader);
+}
+
+bool LightClient::verifyTransaction(const Hash256& txId, std::size_t height, const MerkleProof& proof) const {
+    if (getConfirmations(height) == 0) return false;
+    return MerkleTree::verifyProof(txId, proof, getHeader(height).getMerkleRoot());
+}
+
+bool LightClient::verifyTransaction(const Transaction& tx, std::size_t height, const MerkleProof& proof) const {
+    return verifyTransaction(tx.getId(), height, proof);
+}
@@ -0,0 +1,246 @@
+// src/Mempool.cpp
+#include "Mempool.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+Mempool::Mempool(const MempoolOptions& options)
+    : options(options), count(0), nextSequence(0), admittedFees(0)
+{
+    unsigned int shardCount = options.shards > 0 ? options.shards : 1;
+    shards.reserve(shardCount);
+    for (unsigned int i = 0; i < shardCount; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+Mempool::Shard& Mempool::shardFor(const Hash256& sender) const {
+    return *shards[std::hash<Hash256>()(sender) % shards.size()];
+}
+
+AdmitResult Mempool::add(const Transaction& tx, Amount spendLimit) {
+    // Mining rewards are created by the miner and never pass through the pool
+    if (!tx.isValid()) return AdmitResult::Invalid;
+
+    Entry entry{tx, tx.getId(), 0, Transaction::SERIALIZED_SIZE + SIGNATURE_SIZE, 0.0};
+    entry.feeRate = static_cast<double>(tx.getFee()) / static_cast<double>(entry.size);
+
+    Shard& shard = shardFor(tx.getSender());
+    auto check = [&]() {
+        if (shard.byId.count(entry.id)) return AdmitResult::Duplicate;
+        // amount + fee is bounded by isValid(); the running total is not
+        Amount total;
+        if (!checkedAdd(pendingSpendLocked(shard, tx.getSender()), tx.getAmount() + tx.getFee(), total) ||
+            total > spendLimit) {
+            return AdmitResult::InsufficientFunds;
+        }
+        return AdmitResult::Accepted;
+    };
+
+    // A newcomer that would be rejected anyway must not evict anything
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        AdmitResult result = check();
+        if (result != AdmitResult::Accepted) return result;
+    }
+
+    // Reserve a slot; at capacity the newcomer must out-bid the cheapest pending transaction,
+    // whose slot then passes straight to it
+    std::size_t current = count.load(std::memory_order_relaxed);
+    do {
+        if (current >= options.capacity) {
+            if (!evictBelow(entry.feeRate)) return AdmitResult::PoolFull;
+            break;
+        }
+    } while (!count.compare_exchange_weak(current, current + 1, std::memory_order_relaxed));
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    AdmitResult result = check();  // Another producer may have got in first
+    if (result != AdmitResult::Accepted) {
+        count.fetch_sub(1, std::memory_order_relaxed);
+        return result;
+    }
+
+    entry.sequence = nextSequence.fetch_add(1, std::memory_order_relaxed);
+    shard.bySender[tx.getSender()].push_back(entry.id);
+    shard.pendingSpends[tx.getSender()] = pendingSpendLocked(shard, tx.getSender()) + tx.getAmount() + tx.getFee();
+    shard.byFeeRate.emplace(entry.feeRate, entry.id);
+    shard.byId.emplace(entry.id, std::move(entry));
+    admittedFees.fetch_add(tx.getFee(), std::memory_order_relaxed);
+    return AdmitResult::Accepted;
+}
+
+Amount Mempool::pendingSpendLocked(const Shard& shard, const Hash256& sender) {
+    auto spent = shard.pendingSpends.find(sender);
+    return spent != shard.pendingSpends.end() ? spent->second : 0;
+}
+
+bool Mempool::evictBelow(double feeRate) {
+    // Find the globally cheapest entry one shard lock at a time, then evict it if still present
+    Shard* cheapest = nullptr;
+    double lowest = feeRate;
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        if (!shard->byFeeRate.empty() && shard->byFeeRate.begin()->first < lowest) {
+            lowest = shard->byFeeRate.begin()->first;
+            cheapest = shard.get();
+        }
+    }
+    if (!cheapest) return false;
+
+    std::lock_guard<std::mutex> lock(cheapest->mutex);
+    if (cheapest->byFeeRate.empty() || cheapest->byFeeRate.begin()->first >= feeRate) return false;
+    eraseLocked(*cheapest, cheapest->byFeeRate.begin()->second);  // Keeps its slot in count for the caller
+    return true;
+}
+
+bool Mempool::eraseLocked(Shard& shard, const Hash256& id) {
+    auto it = shard.byId.find(id);
+    if (it == shard.byId.end()) return false;
+    const Entry& entry = it->second;
+    const Hash256& sender = entry.tx.getSender();
+
+    auto queue = shard.bySender.find(sender);
+    if (queue != shard.bySender.end()) {
+        auto position = std::find(queue->second.begin(), queue->second.end(), id);
+        if (position != queue->second.end()) queue->second.erase(position);
+        if (queue->second.empty()) shard.bySender.erase(queue);
+    }
+
+    auto spent = shard.pendingSpends.find(sender);
+    if (spent != shard.pendingSpends.end()) {
+        spent->second -= entry.tx.getAmount() + entry.tx.getFee();
+        if (!shard.bySender.count(sender)) shard.pendingSpends.erase(spent);
+    }
+
+    auto range = shard.byFeeRate.equal_range(entry.feeRate);
+    for (auto fee = range.first; fee != range.second; ++fee) {
+        if (fee->second == id) {
+            shard.byFeeRate.erase(fee);
+            break;
+        }
+    }
+
+    shard.byId.erase(it);
+    return true;
+}
+
+bool Mempool::contains(const Hash256& id) const {
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        if (shard->byId.count(id)) return true;
+    }
+    return false;
+}
+
+std::size_t Mempool::size() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+Amount Mempool::getPendingSpend(const Hash256& sender) const {
+    Shard& shard = shardFor(sender);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return pendingSpendLocked(shard, sender);
+}
+
+std::uint64_t Mempool::getAdmittedCount() const {
+    return nextSequence.load(std::memory_order_relaxed);
+}
+
+Amount Mempool::getAdmittedFees() const {
+    return admittedFees.load(std::memory_order_relaxed);
+}
+
+std::vector<Transaction> Mempool::selectForBlock() const {
+    // Copy each sender's queue in arrival order
+    std::vector<std::vector<Entry>> queues;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (const auto& sender : shard->bySender) {
+            std::vector<Entry> queue;
+            queue.reserve(sender.second.size());
+            for (const auto& id : sender.second) {
+                queue.push_back(shard->byId.at(id));
+            }
+            queues.push_back(std::move(queue));
+        }
+    }
+
+    // Only each sender's next transaction competes, so their order is preserved
+    auto lowerPriority = [&queues](const std::pair<size_t, size_t>& a, const std::pair<size_t, size_t>& b) {
+        const Entry& left = queues[a.first][a.second];
+        const Entry& right = queues[b.first][b.second];
+        if (left.feeRate != right.feeRate) return left.feeRate < right.feeRate;
+        return left.sequence > right.sequence;
+    };
+    std::priority_queue<std::pair<size_t, size_t>, std::vector<std::pair<size_t, size_t>>, decltype(lowerPriority)> heads(lowerPriority);
+    for (size_t q = 0; q < queues.size(); ++q) {
+        heads.emplace(q, 0);
+    }
+
+    std::vector<Transaction> selected;
+    std::size_t bytes = 0;
+    while (!heads.empty() && selected.size() < options.maxBlockTransactions) {
+        auto head = heads.top();
+        heads.pop();
+        const Entry& entry = queues[head.first][head.second];
+        // A transaction that does not fit also holds back the rest of its sender's queue
+        if (bytes + entry.size > options.maxBlockBytes) continue;
+
+        selected.push_back(entry.tx);
+        bytes += entry.size;
+        if (head.second + 1 < queues[head.first].size()) {
+            heads.emplace(head.first, head.second + 1);
+        }
+    }
+    return selected;
+}
+
+void Mempool::removeConfirmed(const std::vector<Transaction>& transactions) {
+    for (const auto& tx : transactions) {
+        if (tx.isReward()) continue;
+        Shard& shard = shardFor(tx.getSender());
+        Hash256 id = tx.getId();
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (eraseLocked(shard, id)) count.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+void Mempool::forEach(const std::function<void(const Hash256&, const Transaction&)>& visit) const {
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (const auto& item : shard->byId) {
+            visit(item.first, item.second.tx);
+        }
+    }
+}
+
+std::vector<Transaction> Mempool::snapshot() const {
+    std::vector<std::pair<std::uint64_t, const Transaction*>> ordered;
+    std::vector<Transaction> copies;
+    copies.reserve(size());
+
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (const auto& item : shard->byId) {
+            copies.push_back(item.second.tx);
+            ordered.emplace_back(item.second.sequence, nullptr);
+        }
+    }
+    for (size_t i = 0; i < copies.size(); ++i) {
+        ordered[i].second = &copies[i];
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<Transaction> result;
+    result.reserve(ordered.size());
+    for (const auto& item : ordered) {
+        result.push_back(*item.second);
+    }
+    return result;
+}
+
+const MempoolOptions& Mempool::getOptions() const {
+    return options;
+}
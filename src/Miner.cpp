@@ -0,0 +1,123 @@
+// src/Miner.cpp
+#include "Miner.h"
+#include "BlockArena.h"
+#include "metrics/ChainMetrics.h"
+#include <stdexcept>
+
+Miner::Miner(Blockchain& blockchain, const Hash256& rewardAddress, const MinerOptions& options)
+    : blockchain(blockchain), rewardAddress(rewardAddress), options(options), stopping(false), blocksMined(0) {
+    if (this->options.threads == 0) {
+        this->options.threads = std::thread::hardware_concurrency();
+        if (this->options.threads == 0) this->options.threads = 1;
+    }
+}
+
+Miner::~Miner() {
+    stop();
+}
+
+void Miner::start(BlockCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (worker.joinable()) {
+        throw std::logic_error("Miner::start: already running");
+    }
+    onBlock = std::move(callback);
+    stopping = false;
+    worker = std::thread([this] { workerLoop(); });
+}
+
+void Miner::stop() {
+    std::thread running;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        running = std::move(worker);
+    }
+    if (running.joinable()) running.join();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& waiter : waiters) {
+        waiter.set_exception(std::make_exception_ptr(std::runtime_error("Miner stopped before finding a block")));
+    }
+    waiters.clear();
+}
+
+bool Miner::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return worker.joinable() && !stopping;
+}
+
+std::future<Block> Miner::nextBlock() {
+    std::lock_guard<std::mutex> lock(mutex);
+    waiters.emplace_back();
+    return waiters.back().get_future();
+}
+
+unsigned long long Miner::getBlocksMined() const {
+    return blocksMined.load();
+}
+
+void Miner::workerLoop() {
+    ChainMetrics& metrics = ChainMetrics::get();
+
+    while (!stopping) {
+        auto buildStart = std::chrono::steady_clock::now();
+        // Held for this template only; setMempoolOptions may swap in a new pool meanwhile
+        std::shared_ptr<const Mempool> mempool = blockchain.getMempool();
+
+        // Fees admitted after this mark count towards a refresh, even if the template picks them up
+        Amount feeMark = mempool->getAdmittedFees();
+        std::vector<Transaction> transactions = blockchain.selectBlockTransactions(rewardAddress);
+        BlockArena arena(transactions.size());
+        Block block = blockchain.createBlockTemplate(transactions, arena.get());
+        const size_t height = static_cast<size_t>(block.getIndex());
+
+        // The search runs on its own thread so this one can keep watching the chain
+        auto sealStart = std::chrono::steady_clock::now();
+        std::atomic<bool> interrupt{false};
+        auto search = std::async(std::launch::async, [&] {
+            return block.mineBlock(blockchain.getDifficulty(), options.threads, &interrupt);
+        });
+        while (search.wait_for(options.pollInterval) != std::future_status::ready) {
+            bool stale = blockchain.getBlockCount() != height;
+            bool richer = !stale && mempool->getAdmittedFees() - feeMark >= options.refreshFees;
+            if (!stopping && !stale && !richer) continue;
+
+            if (stale) metrics.miningStale.inc();
+            if (richer) metrics.miningRefreshes.inc();
+            interrupt = true;
+            break;
+        }
+        MiningStats stats = search.get();
+        auto sealEnd = std::chrono::steady_clock::now();
+        if (stats.interrupted) continue;
+
+        // A block can still lose the race between the last poll and submission. A template
+        // refused for its contents has had the offenders dropped, so the next one differs.
+        if (!blockchain.submitBlock(block)) {
+            if (!interrupt && blockchain.getBlockCount() != height) metrics.miningStale.inc();
+            continue;
+        }
+
+        blocksMined++;
+        metrics.blocksMined.inc();
+        metrics.blockBuildSeconds.observe(std::chrono::duration<double>(sealStart - buildStart).count());
+        metrics.blockSealSeconds.observe(std::chrono::duration<double>(sealEnd - sealStart).count());
+        metrics.blockTransactions.observe(static_cast<double>(transactions.size()));
+        publish(block, stats);
+    }
+}
+
+void Miner::publish(const Block& block, const MiningStats& stats) {
+    std::vector<std::promise<Block>> ready;
+    BlockCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.swap(waiters);
+        callback = onBlock;
+    }
+    for (auto& waiter : ready) {
+        waiter.set_value(block);
+    }
+    if (callback) callback(block, stats);
+}
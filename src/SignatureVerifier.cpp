@@ -0,0 +1,206 @@
+// src/SignatureVerifier.cpp
+#include "SignatureVerifier.h"
+#include "metrics/ChainMetrics.h"
+#include "utils/Encoding.h"
+#include "utils/Hashing.h"
+#include <chrono>
+#include <openssl/bio.h>
+#include <openssl/bn.h>
+#include <openssl/ecdsa.h>
+#include <openssl/pem.h>
+
+namespace {
+    // One digest context per thread, reset rather than reallocated between checks
+    struct DigestContext {
+        EVP_MD_CTX* ctx;
+        DigestContext() : ctx(EVP_MD_CTX_new()) {}
+        ~DigestContext() { EVP_MD_CTX_free(ctx); }
+    };
+
+    EVP_MD_CTX* threadDigestContext() {
+        thread_local DigestContext context;
+        EVP_MD_CTX_reset(context.ctx);
+        return context.ctx;
+    }
+
+    bool decodeBase64(const std::string& encoded, std::vector<unsigned char>& out) {
+        if (encoded.empty()) return false;
+        out.resize(Encoding::maxBase64DecodedSize(encoded.size()));  // Reuses capacity after the first call
+        std::size_t length = 0;
+        if (!Encoding::fromBase64(encoded.data(), encoded.size(), out.data(), length)) return false;
+        out.resize(length);
+        return true;
+    }
+
+    EVP_PKEY* parsePublicKey(const std::string& publicKeyPem) {
+        BIO* bio = BIO_new_mem_buf(publicKeyPem.data(), static_cast<int>(publicKeyPem.size()));
+        EVP_PKEY* key = PEM_read_bio_PUBKEY(bio, nullptr, nullptr, nullptr);
+        BIO_free(bio);
+        return key;
+    }
+}
+
+SignatureVerifier::SignatureVerifier(std::size_t cacheCapacity, unsigned int threadCount)
+    : cacheCapacity(cacheCapacity > 0 ? cacheCapacity : 1), threadCount(threadCount)
+{
+}
+
+SignatureVerifier::~SignatureVerifier() {
+    for (auto& entry : recentKeys) {
+        EVP_PKEY_free(entry.second);
+    }
+}
+
+Hash256 SignatureVerifier::registerPublicKey(const std::string& publicKeyPem) {
+    Hash256 address = Hashing::sha256(publicKeyPem);
+    std::lock_guard<std::mutex> lock(mutex);
+    publicKeys.emplace(address, publicKeyPem);
+    return address;
+}
+
+bool SignatureVerifier::hasPublicKey(const Hash256& address) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return publicKeys.count(address) > 0;
+}
+
+EVP_PKEY* SignatureVerifier::acquireKey(const Hash256& address) {
+    std::string publicKeyPem;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto cached = cachedKeys.find(address);
+        if (cached != cachedKeys.end()) {
+            ChainMetrics::get().keyCacheHits.inc();
+            recentKeys.splice(recentKeys.begin(), recentKeys, cached->second);
+            EVP_PKEY_up_ref(cached->second->second);
+            return cached->second->second;
+        }
+        auto known = publicKeys.find(address);
+        if (known == publicKeys.end()) return nullptr;
+        publicKeyPem = known->second;
+    }
+    return acquireKeyFromPem(address, publicKeyPem);
+}
+
+EVP_PKEY* SignatureVerifier::acquireKeyFromPem(const Hash256& address, const std::string& publicKeyPem) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto cached = cachedKeys.find(address);
+        if (cached != cachedKeys.end()) {
+            ChainMetrics::get().keyCacheHits.inc();
+            recentKeys.splice(recentKeys.begin(), recentKeys, cached->second);
+            EVP_PKEY_up_ref(cached->second->second);
+            return cached->second->second;
+        }
+    }
+
+    // Parse outside the lock; another thread may race us to the same key
+    ChainMetrics::get().keyCacheMisses.inc();
+    EVP_PKEY* parsed = parsePublicKey(publicKeyPem);
+    if (!parsed) return nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    publicKeys.emplace(address, publicKeyPem);
+    auto cached = cachedKeys.find(address);
+    if (cached != cachedKeys.end()) {
+        EVP_PKEY_free(parsed);
+        parsed = cached->second->second;
+    } else {
+        recentKeys.emplace_front(address, parsed);
+        cachedKeys[address] = recentKeys.begin();
+        while (recentKeys.size() > cacheCapacity) {
+            cachedKeys.erase(recentKeys.back().first);
+            EVP_PKEY_free(recentKeys.back().second);  // In-flight checks hold their own reference
+            recentKeys.pop_back();
+        }
+    }
+    EVP_PKEY_up_ref(parsed);
+    return parsed;
+}
+
+bool SignatureVerifier::verifyWithKey(EVP_PKEY* key, const std::string& message,
+                                      const unsigned char* signature, std::size_t signatureLength) {
+    EVP_MD_CTX* ctx = threadDigestContext();
+    const unsigned char* msg = reinterpret_cast<const unsigned char*>(message.data());
+    if (EVP_PKEY_base_id(key) == EVP_PKEY_ED25519) {
+        // Ed25519 hashes internally and only supports one-shot verification
+        if (EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr, key) != 1) return false;
+        return EVP_DigestVerify(ctx, signature, signatureLength, msg, message.size()) == 1;
+    }
+    if (EVP_DigestVerifyInit(ctx, nullptr, EVP_sha256(), nullptr, key) != 1) return false;
+    if (EVP_DigestVerifyUpdate(ctx, msg, message.size()) != 1) return false;
+    return EVP_DigestVerifyFinal(ctx, signature, signatureLength) == 1;
+}
+
+bool SignatureVerifier::verifyCompact(EVP_PKEY* key, const std::string& message, const Signature& signature) {
+    if (EVP_PKEY_base_id(key) != EVP_PKEY_EC) {
+        return verifyWithKey(key, message, signature.data(), signature.size());
+    }
+
+    // ECDSA signatures sit in the slot as r || s; OpenSSL verifies DER
+    ECDSA_SIG* sig = ECDSA_SIG_new();
+    BIGNUM* r = BN_bin2bn(signature.data(), SIGNATURE_SIZE / 2, nullptr);
+    BIGNUM* s = BN_bin2bn(signature.data() + SIGNATURE_SIZE / 2, SIGNATURE_SIZE / 2, nullptr);
+    ECDSA_SIG_set0(sig, r, s);
+    unsigned char der[SIGNATURE_SIZE + 8];
+    unsigned char* cursor = der;
+    int derLength = i2d_ECDSA_SIG(sig, &cursor);
+    ECDSA_SIG_free(sig);
+    if (derLength <= 0) return false;
+    return verifyWithKey(key, message, der, static_cast<std::size_t>(derLength));
+}
+
+bool SignatureVerifier::verify(const Hash256& address, const std::string& message, const Signature& signature) {
+    EVP_PKEY* key = acquireKey(address);
+    if (!key) {
+        ChainMetrics::get().signaturesInvalid.inc();
+        return false;
+    }
+    bool result = verifyCompact(key, message, signature);
+    EVP_PKEY_free(key);
+    ChainMetrics& metrics = ChainMetrics::get();
+    (result ? metrics.signaturesValid : metrics.signaturesInvalid).inc();
+    return result;
+}
+
+bool SignatureVerifier::verifyPem(const std::string& publicKeyPem, const std::string& message, const std::string& signatureBase64) {
+    thread_local std::vector<unsigned char> signature;
+    if (!decodeBase64(signatureBase64, signature)) return false;
+
+    // Hashing the PEM to find its address is far cheaper than parsing it again
+    EVP_PKEY* key = acquireKeyFromPem(Hashing::sha256(publicKeyPem), publicKeyPem);
+    if (!key) return false;
+    bool result = verifyWithKey(key, message, signature.data(), signature.size());
+    EVP_PKEY_free(key);
+    return result;
+}
+
+std::vector<bool> SignatureVerifier::verifyBatch(const std::vector<SignatureCheck>& checks) {
+    auto start = std::chrono::steady_clock::now();
+    // std::vector<bool> packs bits, so workers write bytes and we convert afterwards
+    std::vector<unsigned char> results(checks.size(), 0);
+    auto check = [&](std::size_t i) {
+        results[i] = verify(checks[i].address, checks[i].message, checks[i].signature) ? 1 : 0;
+    };
+
+    if (checks.size() < 2) {
+        for (std::size_t i = 0; i < checks.size(); ++i) check(i);
+    } else {
+        ThreadPool* workers;
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            if (!pool) {
+                pool = std::make_unique<ThreadPool>(threadCount);
+            }
+            workers = pool.get();
+        }
+        workers->parallelFor(checks.size(), check);
+    }
+    ChainMetrics::get().signatureBatchSeconds.observe(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+SignatureVerifier& SignatureVerifier::shared() {
+    static SignatureVerifier instance;
+    return instance;
+}
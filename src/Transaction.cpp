@@ -1,44 +1,94 @@
 // src/Transaction.cpp
 #include "Transaction.h"
 #include "utils/Timestamp.h"
+#include "Wallet.h"
 #include "utils/Hashing.h"
+#include <algorithm>
+#include <cstring>
 
-Transaction::Transaction(std::string sender, std::string receiver, double amount)
-    : sender(std::move(sender)), receiver(std::move(receiver)), amount(amount)
+namespace {
+    unsigned char* putLE(unsigned char* out, std::int64_t value) {
+        std::uint64_t bits = static_cast<std::uint64_t>(value);
+        for (int i = 0; i < 8; ++i) {
+            *out++ = static_cast<unsigned char>(bits >> (8 * i));
+        }
+        return out;
+    }
+}
+
+Transaction::Transaction(const Hash256& sender, const Hash256& receiver, Amount amount, Amount fee)
+    : Transaction(sender, receiver, amount, fee, Timestamp::getCurrentEpochSeconds(), Signature{})
+{
+}
+
+Transaction::Transaction(const Hash256& sender, const Hash256& receiver, Amount amount, Amount fee,
+                         std::int64_t timestamp, const Signature& signature)
+    : sender(sender), receiver(receiver), amount(amount), fee(fee),
+      timestamp(timestamp), signature(signature)
 {
-    timestamp = Timestamp::getCurrentUTCTime();  // e.g., "2025-07-25T23:59:59Z"
-    signature = "";  // Placeholder : For Complex Cryptographic signing and Validation
 }
 
-std::string Transaction::getSender() const {
+const Hash256& Transaction::getSender() const {
     return sender;
 }
 
-std::string Transaction::getReceiver() const {
+const Hash256& Transaction::getReceiver() const {
     return receiver;
 }
 
-double Transaction::getAmount() const {
+Amount Transaction::getAmount() const {
     return amount;
 }
 
-std::string Transaction::getTimestamp() const {
+Amount Transaction::getFee() const {
+    return fee;
+}
+
+std::int64_t Transaction::getTimestamp() const {
     return timestamp;
 }
 
-std::string Transaction::getSignature() const {
+const Signature& Transaction::getSignature() const {
     return signature;
 }
 
-std::string Transaction::toString() const {
-    return sender + receiver + std::to_string(amount) + timestamp;
+bool Transaction::isReward() const {
+    return sender.isZero();
+}
+
+void Transaction::serialize(unsigned char* out) const {
+    std::memcpy(out, sender.data(), Hash256::SIZE);
+    std::memcpy(out + Hash256::SIZE, receiver.data(), Hash256::SIZE);
+    out = putLE(out + 2 * Hash256::SIZE, amount);
+    out = putLE(out, fee);
+    putLE(out, timestamp);
+}
+
+std::string Transaction::serialize() const {
+    std::string out(SERIALIZED_SIZE, '\0');
+    serialize(reinterpret_cast<unsigned char*>(&out[0]));
+    return out;
+}
+
+Hash256 Transaction::getId() const {
+    unsigned char bytes[SERIALIZED_SIZE];
+    serialize(bytes);
+    return Hashing::sha256(bytes, sizeof(bytes));
 }
 
 void Transaction::signTransaction(const std::string& privateKey) {
-    signature = Hashing::sha256(privateKey + toString());
+    Hash256 digest = Hashing::sha256(privateKey + serialize());
+    signature.fill(0);
+    std::copy(digest.bytes.begin(), digest.bytes.end(), signature.begin());
+}
+
+void Transaction::signTransaction(const Wallet& wallet) {
+    signature = wallet.signCompact(serialize());
 }
 
 bool Transaction::isValid() const { 
-    // basic validation logic : sender and receiver should not be empty, amount should be positive
-    return !sender.empty() && !receiver.empty() && amount > 0;
+    // basic validation logic : sender and receiver should be set, amount should be positive;
+    // both bounded so amount + fee and running totals cannot overflow
+    return !sender.isZero() && !receiver.isZero() && amount > 0 && amount <= MAX_MONEY &&
+           fee >= 0 && fee <= MAX_MONEY;
 }
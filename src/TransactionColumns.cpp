@@ -0,0 +1,55 @@
+// src/TransactionColumns.cpp
+#include "TransactionColumns.h"
+
+TransactionColumns::TransactionColumns(std::pmr::memory_resource* resource)
+    : senders(resource), receivers(resource), amounts(resource), fees(resource),
+      timestamps(resource), signatures(resource)
+{
+}
+
+TransactionColumns::TransactionColumns(const std::vector<Transaction>& transactions, std::pmr::memory_resource* resource)
+    : TransactionColumns(resource)
+{
+    reserve(transactions.size());
+    for (const auto& tx : transactions) {
+        push_back(tx);
+    }
+}
+
+void TransactionColumns::reserve(std::size_t count) {
+    senders.reserve(count);
+    receivers.reserve(count);
+    amounts.reserve(count);
+    fees.reserve(count);
+    timestamps.reserve(count);
+    signatures.reserve(count);
+}
+
+void TransactionColumns::push_back(const Transaction& tx) {
+    senders.push_back(tx.getSender());
+    receivers.push_back(tx.getReceiver());
+    amounts.push_back(tx.getAmount());
+    fees.push_back(tx.getFee());
+    timestamps.push_back(tx.getTimestamp());
+    signatures.push_back(tx.getSignature());
+}
+
+std::size_t TransactionColumns::size() const {
+    return senders.size();
+}
+
+bool TransactionColumns::empty() const {
+    return senders.empty();
+}
+
+Transaction TransactionColumns::operator[](std::size_t i) const {
+    return Transaction(senders[i], receivers[i], amounts[i], fees[i], timestamps[i], signatures[i]);
+}
+
+TransactionColumns::Iterator TransactionColumns::begin() const {
+    return Iterator(this, 0);
+}
+
+TransactionColumns::Iterator TransactionColumns::end() const {
+    return Iterator(this, size());
+}
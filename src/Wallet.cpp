@@ -1,62 +1,92 @@
 // src/Wallet.cpp
 #include "Wallet.h"
+#include "KeyPool.h"
+#include "SignatureVerifier.h"
+#include "utils/Encoding.h"
 #include "utils/Hashing.h"
 #include <openssl/pem.h>
 #include <openssl/err.h>
 #include <openssl/sha.h>
 #include <openssl/bio.h>
 #include <openssl/buffer.h>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/obj_mac.h>
 #include <vector>
 #include <sstream>
 #include <iostream>
+#include <stdexcept>
 
-// Base64 encoding helper functions
+// Base64 encoding helper
 std::string base64Encode(const std::vector<unsigned char>& data) {
-    BIO* bio = BIO_new(BIO_s_mem());
-    BIO* b64 = BIO_new(BIO_f_base64());
-    BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
-    bio = BIO_push(b64, bio);
-    
-    BIO_write(bio, data.data(), data.size());
-    BIO_flush(bio);
-    
-    BUF_MEM* bufferPtr;
-    BIO_get_mem_ptr(bio, &bufferPtr);
-    std::string result(bufferPtr->data, bufferPtr->length);
-    
-    BIO_free_all(bio);
+    std::string result(Encoding::base64Size(data.size()), '\0');
+    Encoding::toBase64(data.data(), data.size(), &result[0]);
     return result;
 }
 
-std::vector<unsigned char> base64Decode(const std::string& encoded) {
-    BIO* bio = BIO_new_mem_buf(encoded.data(), encoded.length());
-    BIO* b64 = BIO_new(BIO_f_base64());
-    BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
-    bio = BIO_push(b64, bio);
-    
-    std::vector<unsigned char> result(encoded.length());
-    int decoded_length = BIO_read(bio, result.data(), encoded.length());
-    result.resize(decoded_length);
-    
-    BIO_free_all(bio);
-    return result;
+EVP_PKEY* Wallet::generateKey(KeyAlgorithm algorithm) {
+    EVP_PKEY* key = nullptr;
+    EVP_PKEY_CTX* ctx = nullptr;
+    bool ok = false;
+
+    switch (algorithm) {
+    case KeyAlgorithm::Rsa2048:
+        ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, nullptr);
+        ok = ctx && EVP_PKEY_keygen_init(ctx) == 1 &&
+             EVP_PKEY_CTX_set_rsa_keygen_bits(ctx, 2048) == 1 &&
+             EVP_PKEY_keygen(ctx, &key) == 1;
+        break;
+    case KeyAlgorithm::Ed25519:
+        ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, nullptr);
+        ok = ctx && EVP_PKEY_keygen_init(ctx) == 1 && EVP_PKEY_keygen(ctx, &key) == 1;
+        break;
+    case KeyAlgorithm::Secp256k1:
+        ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+        ok = ctx && EVP_PKEY_keygen_init(ctx) == 1 &&
+             EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, NID_secp256k1) == 1 &&
+             EVP_PKEY_keygen(ctx, &key) == 1;
+        break;
+    }
+    EVP_PKEY_CTX_free(ctx);
+
+    if (!ok) {
+        EVP_PKEY_free(key);
+        throw std::runtime_error(std::string("Key generation failed for ") + algorithmName(algorithm));
+    }
+    return key;
 }
 
-Wallet::Wallet() {
-    keyPair = EVP_PKEY_new();
-    EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, nullptr);
-    EVP_PKEY_keygen_init(ctx);
-    EVP_PKEY_CTX_set_rsa_keygen_bits(ctx, 2048);
-    EVP_PKEY_keygen(ctx, &keyPair);
-    EVP_PKEY_CTX_free(ctx);
+const char* Wallet::algorithmName(KeyAlgorithm algorithm) {
+    switch (algorithm) {
+    case KeyAlgorithm::Rsa2048: return "rsa2048";
+    case KeyAlgorithm::Ed25519: return "ed25519";
+    case KeyAlgorithm::Secp256k1: return "secp256k1";
+    }
+    return "unknown";
 }
 
+Wallet::Wallet(KeyAlgorithm algorithm) : keyPair(generateKey(algorithm)), algorithm(algorithm) {}
+
+Wallet::Wallet(const Hash256& seed)
+    : keyPair(EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, nullptr, seed.data(), Hash256::SIZE)),
+      algorithm(KeyAlgorithm::Ed25519)
+{
+    if (!keyPair) throw std::runtime_error("Key derivation from seed failed for ed25519");
+}
+
+Wallet::Wallet(KeyPool& pool) : keyPair(pool.take()), algorithm(pool.getAlgorithm()) {}
+
 Wallet::~Wallet() {
     if (keyPair) {
         EVP_PKEY_free(keyPair);
     }
 }
 
+KeyAlgorithm Wallet::getAlgorithm() const {
+    return algorithm;
+}
+
 std::string Wallet::getPublicKey() const {
     BIO* bio = BIO_new(BIO_s_mem());
     PEM_write_bio_PUBKEY(bio, keyPair);
@@ -77,43 +107,75 @@ std::string Wallet::getPrivateKey() const {
     return privKey;
 }
 
-std::string Wallet::getAddress() const {
+Hash256 Wallet::getAddress() const {
     return Hashing::sha256(getPublicKey());  // Simplified address format
 }
 
 std::string Wallet::signMessage(const std::string& message) const {
     EVP_MD_CTX* ctx = EVP_MD_CTX_new();
-    EVP_PKEY_CTX* pctx = nullptr;
-
-    EVP_DigestSignInit(ctx, &pctx, EVP_sha256(), nullptr, keyPair);
-    EVP_DigestSignUpdate(ctx, message.c_str(), message.length());
-
+    const unsigned char* msg = reinterpret_cast<const unsigned char*>(message.data());
+    std::vector<unsigned char> signature;
     size_t sigLen = 0;
-    EVP_DigestSignFinal(ctx, nullptr, &sigLen);
-    std::vector<unsigned char> signature(sigLen);
-    EVP_DigestSignFinal(ctx, signature.data(), &sigLen);
+
+    if (algorithm == KeyAlgorithm::Ed25519) {
+        // Ed25519 hashes internally and only supports one-shot signing
+        EVP_DigestSignInit(ctx, nullptr, nullptr, nullptr, keyPair);
+        EVP_DigestSign(ctx, nullptr, &sigLen, msg, message.length());
+        signature.resize(sigLen);
+        EVP_DigestSign(ctx, signature.data(), &sigLen, msg, message.length());
+    } else {
+        EVP_DigestSignInit(ctx, nullptr, EVP_sha256(), nullptr, keyPair);
+        EVP_DigestSignUpdate(ctx, msg, message.length());
+        EVP_DigestSignFinal(ctx, nullptr, &sigLen);
+        signature.resize(sigLen);
+        EVP_DigestSignFinal(ctx, signature.data(), &sigLen);
+    }
+    signature.resize(sigLen);  // ECDSA DER signatures can be shorter than the bound
 
     EVP_MD_CTX_free(ctx);
 
     return base64Encode(signature);
 }
 
-bool Wallet::verifySignature(const std::string& publicKeyPem, const std::string& message, const std::string& signatureBase64) {
-    BIO* bio = BIO_new_mem_buf(publicKeyPem.data(), -1);
-    EVP_PKEY* pubKey = PEM_read_bio_PUBKEY(bio, nullptr, nullptr, nullptr);
-    BIO_free(bio);
-
-    if (!pubKey) return false;
+Signature Wallet::signCompact(const std::string& message) const {
+    if (algorithm == KeyAlgorithm::Rsa2048) {
+        throw std::logic_error("RSA signatures do not fit the transaction signature slot");
+    }
 
     EVP_MD_CTX* ctx = EVP_MD_CTX_new();
-    EVP_DigestVerifyInit(ctx, nullptr, EVP_sha256(), nullptr, pubKey);
-    EVP_DigestVerifyUpdate(ctx, message.c_str(), message.length());
-
-    std::vector<unsigned char> sigBytes = base64Decode(signatureBase64);
-    bool result = EVP_DigestVerifyFinal(ctx, sigBytes.data(), sigBytes.size()) == 1;
+    const unsigned char* msg = reinterpret_cast<const unsigned char*>(message.data());
+    Signature signature{};
+    bool ok = false;
+
+    if (algorithm == KeyAlgorithm::Ed25519) {
+        size_t sigLen = signature.size();
+        ok = ctx && EVP_DigestSignInit(ctx, nullptr, nullptr, nullptr, keyPair) == 1 &&
+             EVP_DigestSign(ctx, signature.data(), &sigLen, msg, message.length()) == 1 &&
+             sigLen == signature.size();
+    } else {
+        // Unpack the DER signature into fixed-width r || s
+        unsigned char der[SIGNATURE_SIZE + 8];
+        size_t derLen = sizeof(der);
+        ok = ctx && EVP_DigestSignInit(ctx, nullptr, EVP_sha256(), nullptr, keyPair) == 1 &&
+             EVP_DigestSignUpdate(ctx, msg, message.length()) == 1 &&
+             EVP_DigestSignFinal(ctx, der, &derLen) == 1;
+
+        const unsigned char* cursor = der;
+        ECDSA_SIG* sig = ok ? d2i_ECDSA_SIG(nullptr, &cursor, static_cast<long>(derLen)) : nullptr;
+        ok = sig &&
+             BN_bn2binpad(ECDSA_SIG_get0_r(sig), signature.data(), SIGNATURE_SIZE / 2) == SIGNATURE_SIZE / 2 &&
+             BN_bn2binpad(ECDSA_SIG_get0_s(sig), signature.data() + SIGNATURE_SIZE / 2, SIGNATURE_SIZE / 2) == SIGNATURE_SIZE / 2;
+        ECDSA_SIG_free(sig);
+    }
 
     EVP_MD_CTX_free(ctx);
-    EVP_PKEY_free(pubKey);
+    if (!ok) {
+        throw std::runtime_error(std::string("Signing failed for ") + algorithmName(algorithm));
+    }
+    return signature;
+}
 
-    return result;
+bool Wallet::verifySignature(const std::string& publicKeyPem, const std::string& message, const std::string& signatureBase64) {
+    // Parsed keys and digest contexts are cached by the shared verification engine
+    return SignatureVerifier::shared().verifyPem(publicKeyPem, message, signatureBase64);
 }
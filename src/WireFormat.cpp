@@ -0,0 +1,313 @@
+// src/WireFormat.cpp
+#include "WireFormat.h"
+#include "utils/Hashing.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    const unsigned char FLAG_REWARD = 0x01;
+    const unsigned char FLAG_UNSIGNED = 0x02;
+
+    bool isUnsigned(const Signature& signature) {
+        return std::all_of(signature.begin(), signature.end(), [](unsigned char b) { return b == 0; });
+    }
+
+    bool isAllZero(const unsigned char* bytes, std::size_t size) {
+        return std::all_of(bytes, bytes + size, [](unsigned char b) { return b == 0; });
+    }
+
+    const unsigned char* take(const unsigned char*& cursor, const unsigned char* end, std::size_t count) {
+        if (static_cast<std::size_t>(end - cursor) < count) {
+            throw std::runtime_error("WireFormat: truncated input");
+        }
+        const unsigned char* start = cursor;
+        cursor += count;
+        return start;
+    }
+
+    std::size_t rowSize(const Hash256& sender, Amount amount, Amount fee, std::int64_t timestamp,
+                        const Signature& signature) {
+        return 1 + (sender.isZero() ? 0 : Hash256::SIZE) + Hash256::SIZE +
+               WireFormat::varintSize(WireFormat::zigzag(amount)) + WireFormat::varintSize(WireFormat::zigzag(fee)) +
+               WireFormat::varintSize(WireFormat::zigzag(timestamp)) + (isUnsigned(signature) ? 0 : SIGNATURE_SIZE);
+    }
+
+    unsigned char* putRow(unsigned char* out, const Hash256& sender, const Hash256& receiver, Amount amount,
+                          Amount fee, std::int64_t timestamp, const Signature& signature) {
+        bool reward = sender.isZero();
+        bool unsignedTx = isUnsigned(signature);
+        *out++ = static_cast<unsigned char>((reward ? FLAG_REWARD : 0) | (unsignedTx ? FLAG_UNSIGNED : 0));
+        if (!reward) {
+            std::memcpy(out, sender.data(), Hash256::SIZE);
+            out += Hash256::SIZE;
+        }
+        std::memcpy(out, receiver.data(), Hash256::SIZE);
+        out += Hash256::SIZE;
+        out = WireFormat::putVarint(out, WireFormat::zigzag(amount));
+        out = WireFormat::putVarint(out, WireFormat::zigzag(fee));
+        out = WireFormat::putVarint(out, WireFormat::zigzag(timestamp));
+        if (!unsignedTx) {
+            std::memcpy(out, signature.data(), SIGNATURE_SIZE);
+            out += SIGNATURE_SIZE;
+        }
+        return out;
+    }
+}
+
+std::size_t WireFormat::varintSize(std::uint64_t value) {
+    std::size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+unsigned char* WireFormat::putVarint(unsigned char* out, std::uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<unsigned char>(value);
+    return out;
+}
+
+std::uint64_t WireFormat::readVarint(const unsigned char*& cursor, const unsigned char* end) {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < MAX_VARINT_SIZE; ++i) {
+        if (cursor == end) throw std::runtime_error("WireFormat: truncated varint");
+        unsigned char byte = *cursor++;
+        if (i == MAX_VARINT_SIZE - 1 && byte > 1) {
+            throw std::runtime_error("WireFormat: varint overflows 64 bits");
+        }
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << (7 * i);
+        if (!(byte & 0x80)) {
+            // A zero final byte means a shorter encoding existed
+            if (byte == 0 && i > 0) throw std::runtime_error("WireFormat: overlong varint");
+            return value;
+        }
+    }
+    throw std::runtime_error("WireFormat: varint too long");
+}
+
+std::uint64_t WireFormat::zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t WireFormat::unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+unsigned char* WireFormat::encodeHeader(const BlockHeader& header, unsigned char* out) {
+    *out++ = VERSION;
+    std::memcpy(out, header.bytes, BlockHeader::SIZE);
+    return out + BlockHeader::SIZE;
+}
+
+BlockHeader WireFormat::decodeHeader(const unsigned char* data, std::size_t size) {
+    if (size < HEADER_SIZE) throw std::runtime_error("WireFormat: truncated header");
+    if (data[0] != VERSION) throw std::runtime_error("WireFormat: unsupported version");
+    return BlockHeader::fromBytes(data + 1);
+}
+
+std::size_t WireFormat::encodedSize(const Transaction& tx) {
+    return rowSize(tx.getSender(), tx.getAmount(), tx.getFee(), tx.getTimestamp(), tx.getSignature());
+}
+
+unsigned char* WireFormat::encode(const Transaction& tx, unsigned char* out) {
+    return putRow(out, tx.getSender(), tx.getReceiver(), tx.getAmount(), tx.getFee(), tx.getTimestamp(),
+                  tx.getSignature());
+}
+
+std::vector<unsigned char> WireFormat::encode(const Transaction& tx) {
+    std::vector<unsigned char> out(encodedSize(tx));
+    encode(tx, out.data());
+    return out;
+}
+
+Transaction WireFormat::decodeTransaction(const unsigned char* data, std::size_t size) {
+    TransactionView view;
+    if (view.parse(data, data + size) != data + size) {
+        throw std::runtime_error("WireFormat: trailing bytes after transaction");
+    }
+    return view.toTransaction();
+}
+
+std::size_t WireFormat::encodedSize(const Block& block) {
+    const TransactionColumns& txs = block.getTransactions();
+    std::size_t size = HEADER_SIZE + varintSize(txs.size());
+    for (std::size_t i = 0; i < txs.size(); ++i) {
+        size += rowSize(txs.senders[i], txs.amounts[i], txs.fees[i], txs.timestamps[i], txs.signatures[i]);
+    }
+    return size;
+}
+
+unsigned char* WireFormat::encode(const Block& block, unsigned char* out) {
+    // Rows come straight from the block's columns; no Transaction objects in between
+    const TransactionColumns& txs = block.getTransactions();
+    out = encodeHeader(block.getHeader(), out);
+    out = putVarint(out, txs.size());
+    for (std::size_t i = 0; i < txs.size(); ++i) {
+        out = putRow(out, txs.senders[i], txs.receivers[i], txs.amounts[i], txs.fees[i], txs.timestamps[i],
+                     txs.signatures[i]);
+    }
+    return out;
+}
+
+std::vector<unsigned char> WireFormat::encode(const Block& block) {
+    std::vector<unsigned char> out(encodedSize(block));
+    encode(block, out.data());
+    return out;
+}
+
+Block WireFormat::decodeBlock(const unsigned char* data, std::size_t size) {
+    BlockReader reader(data, size);
+    TransactionColumns transactions;
+    transactions.reserve(reader.getTransactionCount());
+
+    TransactionView tx;
+    while (reader.next(tx)) {
+        transactions.senders.push_back(tx.getSender());
+        transactions.receivers.push_back(tx.getReceiver());
+        transactions.amounts.push_back(tx.getAmount());
+        transactions.fees.push_back(tx.getFee());
+        transactions.timestamps.push_back(tx.getTimestamp());
+        transactions.signatures.push_back(tx.getSignature());
+    }
+    return Block(reader.getHeader(), std::move(transactions));
+}
+
+TransactionView::TransactionView()
+    : start(nullptr), sender(nullptr), receiver(nullptr), signature(nullptr),
+      amount(0), fee(0), timestamp(0), length(0) {}
+
+const unsigned char* TransactionView::parse(const unsigned char* data, const unsigned char* end) {
+    const unsigned char* cursor = data;
+    unsigned char flags = *take(cursor, end, 1);
+    if (flags & ~(FLAG_REWARD | FLAG_UNSIGNED)) throw std::runtime_error("WireFormat: unknown transaction flags");
+
+    // A zero sender or signature must use its flag instead, keeping the encoding unique
+    const unsigned char* parsedSender = nullptr;
+    if (!(flags & FLAG_REWARD)) {
+        parsedSender = take(cursor, end, Hash256::SIZE);
+        if (isAllZero(parsedSender, Hash256::SIZE)) throw std::runtime_error("WireFormat: zero sender without reward flag");
+    }
+    const unsigned char* parsedReceiver = take(cursor, end, Hash256::SIZE);
+    Amount parsedAmount = WireFormat::unzigzag(WireFormat::readVarint(cursor, end));
+    Amount parsedFee = WireFormat::unzigzag(WireFormat::readVarint(cursor, end));
+    std::int64_t parsedTimestamp = WireFormat::unzigzag(WireFormat::readVarint(cursor, end));
+    const unsigned char* parsedSignature = nullptr;
+    if (!(flags & FLAG_UNSIGNED)) {
+        parsedSignature = take(cursor, end, SIGNATURE_SIZE);
+        if (isAllZero(parsedSignature, SIGNATURE_SIZE)) throw std::runtime_error("WireFormat: zero signature without unsigned flag");
+    }
+
+    start = data;
+    sender = parsedSender;
+    receiver = parsedReceiver;
+    signature = parsedSignature;
+    amount = parsedAmount;
+    fee = parsedFee;
+    timestamp = parsedTimestamp;
+    length = static_cast<std::size_t>(cursor - data);
+    return cursor;
+}
+
+Span<const unsigned char> TransactionView::encoded() const {
+    return Span<const unsigned char>(start, length);
+}
+
+bool TransactionView::isReward() const {
+    return sender == nullptr;
+}
+
+bool TransactionView::isSigned() const {
+    return signature != nullptr;
+}
+
+Hash256 TransactionView::getSender() const {
+    Hash256 hash;
+    if (sender) std::memcpy(hash.data(), sender, Hash256::SIZE);
+    return hash;
+}
+
+Hash256 TransactionView::getReceiver() const {
+    Hash256 hash;
+    std::memcpy(hash.data(), receiver, Hash256::SIZE);
+    return hash;
+}
+
+Amount TransactionView::getAmount() const {
+    return amount;
+}
+
+Amount TransactionView::getFee() const {
+    return fee;
+}
+
+std::int64_t TransactionView::getTimestamp() const {
+    return timestamp;
+}
+
+Signature TransactionView::getSignature() const {
+    Signature value{};
+    if (signature) std::memcpy(value.data(), signature, SIGNATURE_SIZE);
+    return value;
+}
+
+void TransactionView::serialize(unsigned char* out) const {
+    // Mirrors Transaction::serialize: sender | receiver | amount | fee | timestamp, little-endian
+    if (sender) {
+        std::memcpy(out, sender, Hash256::SIZE);
+    } else {
+        std::memset(out, 0, Hash256::SIZE);
+    }
+    std::memcpy(out + Hash256::SIZE, receiver, Hash256::SIZE);
+    out += 2 * Hash256::SIZE;
+    for (std::int64_t value : {amount, fee, timestamp}) {
+        std::uint64_t bits = static_cast<std::uint64_t>(value);
+        for (int i = 0; i < 8; ++i) *out++ = static_cast<unsigned char>(bits >> (8 * i));
+    }
+}
+
+Hash256 TransactionView::getId() const {
+    unsigned char bytes[Transaction::SERIALIZED_SIZE];
+    serialize(bytes);
+    return Hashing::sha256(bytes, sizeof(bytes));
+}
+
+Transaction TransactionView::toTransaction() const {
+    return Transaction(getSender(), getReceiver(), amount, fee, timestamp, getSignature());
+}
+
+BlockReader::BlockReader(const unsigned char* data, std::size_t size)
+    : cursor(data), end(data + size), header(WireFormat::decodeHeader(data, size)),
+      transactionCount(0), position(0)
+{
+    cursor += WireFormat::HEADER_SIZE;
+    std::uint64_t count = WireFormat::readVarint(cursor, end);
+    // Every transaction takes at least its flags, receiver and three varint bytes
+    if (count > static_cast<std::uint64_t>(end - cursor) / (1 + Hash256::SIZE + 3)) {
+        throw std::runtime_error("WireFormat: transaction count exceeds block size");
+    }
+    transactionCount = static_cast<std::size_t>(count);
+}
+
+const BlockHeader& BlockReader::getHeader() const {
+    return header;
+}
+
+std::size_t BlockReader::getTransactionCount() const {
+    return transactionCount;
+}
+
+bool BlockReader::next(TransactionView& tx) {
+    if (position == transactionCount) {
+        if (cursor != end) throw std::runtime_error("WireFormat: trailing bytes after block");
+        return false;
+    }
+    cursor = tx.parse(cursor, end);
+    ++position;
+    return true;
+}
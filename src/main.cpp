@@ -18,12 +18,12 @@ int main() {
     Wallet Dhrumil;
 
     std::cout << "Created 6 wallets with unique addresses:\n";
-    std::cout << "Miner:   " << minerWallet.getAddress().substr(0, 16) << "...\n";
-    std::cout << "Jalaj:   " << Jalaj.getAddress().substr(0, 16) << "...\n";
-    std::cout << "Het:     " << Het.getAddress().substr(0, 16) << "...\n";
-    std::cout << "Matang: " << Matang.getAddress().substr(0, 16) << "...\n";
-    std::cout << "Riken:   " << Riken.getAddress().substr(0, 16) << "...\n";
-    std::cout << "Dhrumil:     " << Dhrumil.getAddress().substr(0, 16) << "...\n\n";
+    std::cout << "Miner:   " << minerWallet.getAddress().toHex().substr(0, 16) << "...\n";
+    std::cout << "Jalaj:   " << Jalaj.getAddress().toHex().substr(0, 16) << "...\n";
+    std::cout << "Het:     " << Het.getAddress().toHex().substr(0, 16) << "...\n";
+    std::cout << "Matang: " << Matang.getAddress().toHex().substr(0, 16) << "...\n";
+    std::cout << "Riken:   " << Riken.getAddress().toHex().substr(0, 16) << "...\n";
+    std::cout << "Dhrumil:     " << Dhrumil.getAddress().toHex().substr(0, 16) << "...\n\n";
 
     // Create the blockchain
     Blockchain blockchain(minerWallet.getAddress());
@@ -31,9 +31,9 @@ int main() {
     // === BLOCK 1: Multiple transactions ===
     std::cout << "Creating Block 1 with multiple transactions...\n";
     
-    Transaction tx1(Jalaj.getAddress(), Het.getAddress(), 25.0);
-    Transaction tx2(Jalaj.getAddress(), Matang.getAddress(), 15.0);
-    Transaction tx3(Het.getAddress(), Riken.getAddress(), 8.5);
+    Transaction tx1(Jalaj.getAddress(), Het.getAddress(), coinsToAmount(25.0));
+    Transaction tx2(Jalaj.getAddress(), Matang.getAddress(), coinsToAmount(15.0));
+    Transaction tx3(Het.getAddress(), Riken.getAddress(), coinsToAmount(8.5));
     
     blockchain.addTransaction(tx1);
     blockchain.addTransaction(tx2);
@@ -46,11 +46,11 @@ int main() {
     // === BLOCK 2: More complex transactions ===
     std::cout << "Creating Block 2 with more transactions...\n";
     
-    Transaction tx4(Matang.getAddress(), Dhrumil.getAddress(), 5.0);
-    Transaction tx5(Riken.getAddress(), Jalaj.getAddress(), 3.0);
-    Transaction tx6(Het.getAddress(), Matang.getAddress(), 12.0);
-    Transaction tx7(Dhrumil.getAddress(), Riken.getAddress(), 2.5);
-    Transaction tx8(Jalaj.getAddress(), Het.getAddress(), 7.5);
+    Transaction tx4(Matang.getAddress(), Dhrumil.getAddress(), coinsToAmount(5.0));
+    Transaction tx5(Riken.getAddress(), Jalaj.getAddress(), coinsToAmount(3.0));
+    Transaction tx6(Het.getAddress(), Matang.getAddress(), coinsToAmount(12.0));
+    Transaction tx7(Dhrumil.getAddress(), Riken.getAddress(), coinsToAmount(2.5));
+    Transaction tx8(Jalaj.getAddress(), Het.getAddress(), coinsToAmount(7.5));
     
     blockchain.addTransaction(tx4);
     blockchain.addTransaction(tx5);
@@ -67,16 +67,16 @@ int main() {
     
     // Create 10 transactions for demonstration
     std::vector<Transaction> highVolumeTxs = {
-        Transaction(Jalaj.getAddress(), Het.getAddress(), 1.0),
-        Transaction(Het.getAddress(), Matang.getAddress(), 2.0),
-        Transaction(Matang.getAddress(), Riken.getAddress(), 1.5),
-        Transaction(Riken.getAddress(), Dhrumil.getAddress(), 3.0),
-        Transaction(Dhrumil.getAddress(), Jalaj.getAddress(), 0.5),
-        Transaction(Jalaj.getAddress(), Matang.getAddress(), 4.0),
-        Transaction(Het.getAddress(), Riken.getAddress(), 2.5),
-        Transaction(Matang.getAddress(), Het.getAddress(), 1.8),
-        Transaction(Riken.getAddress(), Jalaj.getAddress(), 0.7),
-        Transaction(Dhrumil.getAddress(), Het.getAddress(), 3.2)
+        Transaction(Jalaj.getAddress(), Het.getAddress(), coinsToAmount(1.0)),
+        Transaction(Het.getAddress(), Matang.getAddress(), coinsToAmount(2.0)),
+        Transaction(Matang.getAddress(), Riken.getAddress(), coinsToAmount(1.5)),
+        Transaction(Riken.getAddress(), Dhrumil.getAddress(), coinsToAmount(3.0)),
+        Transaction(Dhrumil.getAddress(), Jalaj.getAddress(), coinsToAmount(0.5)),
+        Transaction(Jalaj.getAddress(), Matang.getAddress(), coinsToAmount(4.0)),
+        Transaction(Het.getAddress(), Riken.getAddress(), coinsToAmount(2.5)),
+        Transaction(Matang.getAddress(), Het.getAddress(), coinsToAmount(1.8)),
+        Transaction(Riken.getAddress(), Jalaj.getAddress(), coinsToAmount(0.7)),
+        Transaction(Dhrumil.getAddress(), Het.getAddress(), coinsToAmount(3.2))
     };
     
     for(const auto& tx : highVolumeTxs) {
@@ -93,21 +93,21 @@ int main() {
 
     // === Display all balances ===
     std::cout << "\n=== FINAL BALANCES ===\n";
-    std::cout << "Miner:   " << blockchain.getBalanceOfAddress(minerWallet.getAddress()) << " coins\n";
-    std::cout << "Jalaj:   " << blockchain.getBalanceOfAddress(Jalaj.getAddress()) << " coins\n";
-    std::cout << "Het:     " << blockchain.getBalanceOfAddress(Het.getAddress()) << " coins\n";
-    std::cout << "Matang: " << blockchain.getBalanceOfAddress(Matang.getAddress()) << " coins\n";
-    std::cout << "Riken:   " << blockchain.getBalanceOfAddress(Riken.getAddress()) << " coins\n";
-    std::cout << "Dhrumil:     " << blockchain.getBalanceOfAddress(Dhrumil.getAddress()) << " coins\n";
+    std::cout << "Miner:   " << formatAmount(blockchain.getBalanceOfAddress(minerWallet.getAddress())) << " coins\n";
+    std::cout << "Jalaj:   " << formatAmount(blockchain.getBalanceOfAddress(Jalaj.getAddress())) << " coins\n";
+    std::cout << "Het:     " << formatAmount(blockchain.getBalanceOfAddress(Het.getAddress())) << " coins\n";
+    std::cout << "Matang: " << formatAmount(blockchain.getBalanceOfAddress(Matang.getAddress())) << " coins\n";
+    std::cout << "Riken:   " << formatAmount(blockchain.getBalanceOfAddress(Riken.getAddress())) << " coins\n";
+    std::cout << "Dhrumil:     " << formatAmount(blockchain.getBalanceOfAddress(Dhrumil.getAddress())) << " coins\n";
 
     // === Blockchain statistics ===
     std::cout << "\n=== BLOCKCHAIN STATISTICS ===\n";
-    auto chain = blockchain.getChain();
+    const auto& chain = blockchain.getChain();
     std::cout << "Total Blocks: " << chain.size() << "\n";
     
     int totalTransactions = 0;
     for(const auto& block : chain) {
-        totalTransactions += block.getTransactions().size();
+        totalTransactions += block.getTransactionCount();
     }
     std::cout << "Total Transactions: " << totalTransactions << "\n";
     std::cout << "Mining Difficulty: " << blockchain.getDifficulty() << "\n";
@@ -0,0 +1,53 @@
+#include "metrics/ChainMetrics.h"
+#include "Mempool.h"
+
+namespace {
+    MetricsRegistry& registry() {
+        return MetricsRegistry::global();
+    }
+}
+
+ChainMetrics::ChainMetrics()
+    : miningAttempts(registry().counter("blockchain_mining_attempts_total", "Proof-of-work hashes computed")),
+      miningAttemptsPerBlock(registry().histogram("blockchain_mining_attempts_per_block", "Hashes needed to seal a block",
+                                                  Histogram::exponentialBuckets(16, 4, 14))),
+      miningHashRate(registry().gauge("blockchain_mining_hash_rate", "Hashes per second while sealing the last block")),
+      miningSeconds(registry().histogram("blockchain_mining_seconds", "Wall time of each proof-of-work search")),
+      miningRefreshes(registry().counter("blockchain_mining_interrupts_total", "Background proof-of-work searches cut short",
+                                         "reason=\"refresh\"")),
+      miningStale(registry().counter("blockchain_mining_interrupts_total", "Background proof-of-work searches cut short",
+                                     "reason=\"stale\"")),
+      blocksMined(registry().counter("blockchain_blocks_mined_total", "Blocks mined by this node")),
+      blockBuildSeconds(registry().histogram("blockchain_block_build_seconds", "Time to select transactions and assemble a block")),
+      blockSealSeconds(registry().histogram("blockchain_block_seal_seconds", "Time to find a valid nonce for a block")),
+      blockTransactions(registry().histogram("blockchain_block_transactions", "Transactions per mined block",
+                                             Histogram::exponentialBuckets(1, 2, 17))),
+      chainHeight(registry().gauge("blockchain_chain_height", "Blocks in the chain, genesis included")),
+      mempoolDepth(registry().gauge("blockchain_mempool_depth", "Pending transactions in the mempool")),
+      signatureRejected(registry().counter("blockchain_transactions_admitted_total", "Mempool admission outcomes",
+                                           "result=\"bad_signature\"")),
+      validationSeconds(registry().histogram("blockchain_validation_seconds", "Time spent in each chain validation pass")),
+      blocksValidated(registry().counter("blockchain_blocks_validated_total", "Blocks that passed validation")),
+      validationFailures(registry().counter("blockchain_validation_failures_total", "Validation passes that found an invalid block")),
+      signaturesValid(registry().counter("blockchain_signature_checks_total", "Transaction signature checks", "result=\"valid\"")),
+      signaturesInvalid(registry().counter("blockchain_signature_checks_total", "Transaction signature checks", "result=\"invalid\"")),
+      keyCacheHits(registry().counter("blockchain_signature_key_cache_total", "Parsed public key lookups", "result=\"hit\"")),
+      keyCacheMisses(registry().counter("blockchain_signature_key_cache_total", "Parsed public key lookups", "result=\"miss\"")),
+      signatureBatchSeconds(registry().histogram("blockchain_signature_batch_seconds", "Time to verify one signature batch"))
+{
+    const char* help = "Mempool admission outcomes";
+    admissions[static_cast<int>(AdmitResult::Accepted)] = &registry().counter("blockchain_transactions_admitted_total", help, "result=\"accepted\"");
+    admissions[static_cast<int>(AdmitResult::Duplicate)] = &registry().counter("blockchain_transactions_admitted_total", help, "result=\"duplicate\"");
+    admissions[static_cast<int>(AdmitResult::Invalid)] = &registry().counter("blockchain_transactions_admitted_total", help, "result=\"invalid\"");
+    admissions[static_cast<int>(AdmitResult::InsufficientFunds)] = &registry().counter("blockchain_transactions_admitted_total", help, "result=\"insufficient_funds\"");
+    admissions[static_cast<int>(AdmitResult::PoolFull)] = &registry().counter("blockchain_transactions_admitted_total", help, "result=\"pool_full\"");
+}
+
+void ChainMetrics::recordAdmission(AdmitResult result) {
+    admissions[static_cast<int>(result)]->inc();
+}
+
+ChainMetrics& ChainMetrics::get() {
+    static ChainMetrics metrics;
+    return metrics;
+}
@@ -0,0 +1,170 @@
+#include "metrics/Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    void atomicAdd(std::atomic<double>& target, double delta) {
+        double current = target.load(std::memory_order_relaxed);
+        while (!target.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::string formatValue(double value) {
+        if (std::isinf(value)) return value > 0 ? "+Inf" : "-Inf";
+        if (std::isnan(value)) return "NaN";
+        // Shortest form that still round-trips, so bucket bounds print as 1e-05 rather than 1.0000000000000001e-05
+        char buffer[32];
+        for (int precision = 15; precision <= 17; precision++) {
+            std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+            if (std::strtod(buffer, nullptr) == value) break;
+        }
+        return buffer;
+    }
+
+    std::string seriesName(const std::string& name, const std::string& labels, const std::string& extra = "") {
+        if (labels.empty() && extra.empty()) return name;
+        std::string joined = labels;
+        if (!labels.empty() && !extra.empty()) joined += ",";
+        return name + "{" + joined + extra + "}";
+    }
+}
+
+void Gauge::add(double delta) {
+    atomicAdd(value, delta);
+}
+
+Histogram::Histogram(std::vector<double> upperBounds)
+    : bounds(std::move(upperBounds)), buckets(new std::atomic<std::uint64_t>[bounds.size() + 1])
+{
+    std::sort(bounds.begin(), bounds.end());
+    for (std::size_t i = 0; i <= bounds.size(); ++i) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::observe(double value) {
+    std::size_t bucket = std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin();
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    atomicAdd(sum, value);
+}
+
+std::uint64_t Histogram::getBucketCount(std::size_t bucket) const {
+    return buckets[bucket].load(std::memory_order_relaxed);
+}
+
+std::vector<double> Histogram::exponentialBuckets(double start, double factor, std::size_t count) {
+    std::vector<double> result;
+    result.reserve(count);
+    for (double bound = start; result.size() < count; bound *= factor) {
+        result.push_back(bound);
+    }
+    return result;
+}
+
+std::vector<double> Histogram::latencyBuckets() {
+    return exponentialBuckets(1e-5, 4.0, 12);
+}
+
+MetricsRegistry::Series* MetricsRegistry::find(const std::string& name, const std::string& labels, Kind kind) {
+    for (auto& entry : series) {
+        if (entry.name == name && entry.labels == labels) {
+            if (entry.kind != kind) {
+                throw std::logic_error("MetricsRegistry: " + name + " registered with another type");
+            }
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Series* existing = find(name, labels, Kind::Counter)) return *existing->counter;
+    series.push_back(Series{name, labels, help, Kind::Counter, std::make_unique<Counter>(), nullptr, nullptr});
+    return *series.back().counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Series* existing = find(name, labels, Kind::Gauge)) return *existing->gauge;
+    series.push_back(Series{name, labels, help, Kind::Gauge, nullptr, std::make_unique<Gauge>(), nullptr});
+    return *series.back().gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      const std::vector<double>& bounds, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Series* existing = find(name, labels, Kind::Histogram)) return *existing->histogram;
+    series.push_back(Series{name, labels, help, Kind::Histogram, nullptr, nullptr, std::make_unique<Histogram>(bounds)});
+    return *series.back().histogram;
+}
+
+std::string MetricsRegistry::toPrometheus() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ostringstream out;
+
+    // Group series by metric name so HELP/TYPE appear once per family
+    std::vector<const Series*> ordered;
+    for (const auto& entry : series) ordered.push_back(&entry);
+    std::stable_sort(ordered.begin(), ordered.end(),
+                     [](const Series* a, const Series* b) { return a->name < b->name; });
+
+    const std::string* previous = nullptr;
+    for (const Series* entry : ordered) {
+        if (!previous || *previous != entry->name) {
+            const char* type = entry->kind == Kind::Counter ? "counter" : entry->kind == Kind::Gauge ? "gauge" : "histogram";
+            out << "# HELP " << entry->name << " " << entry->help << "\n";
+            out << "# TYPE " << entry->name << " " << type << "\n";
+            previous = &entry->name;
+        }
+
+        switch (entry->kind) {
+        case Kind::Counter:
+            out << seriesName(entry->name, entry->labels) << " " << entry->counter->get() << "\n";
+            break;
+        case Kind::Gauge:
+            out << seriesName(entry->name, entry->labels) << " " << formatValue(entry->gauge->get()) << "\n";
+            break;
+        case Kind::Histogram: {
+            const Histogram& histogram = *entry->histogram;
+            std::uint64_t cumulative = 0;
+            for (std::size_t i = 0; i <= histogram.getBounds().size(); ++i) {
+                cumulative += histogram.getBucketCount(i);
+                double bound = i < histogram.getBounds().size() ? histogram.getBounds()[i] : INFINITY;
+                out << seriesName(entry->name + "_bucket", entry->labels, "le=\"" + formatValue(bound) + "\"")
+                    << " " << cumulative << "\n";
+            }
+            out << seriesName(entry->name + "_sum", entry->labels) << " " << formatValue(histogram.getSum()) << "\n";
+            out << seriesName(entry->name + "_count", entry->labels) << " " << histogram.getCount() << "\n";
+            break;
+        }
+        }
+    }
+    return out.str();
+}
+
+void MetricsRegistry::writeToFile(const std::string& path) const {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("MetricsRegistry: cannot write " + temporary);
+        out << toPrometheus();
+    }
+#ifdef _WIN32
+    std::remove(path.c_str());  // rename does not replace an existing file on Windows
+#endif
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("MetricsRegistry: cannot replace " + path);
+    }
+}
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry instance;
+    return instance;
+}
@@ -0,0 +1,165 @@
+#include "metrics/MetricsServer.h"
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+using SocketHandle = SOCKET;
+#define pollSockets WSAPoll
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+using SocketHandle = int;
+#define pollSockets poll
+#endif
+
+namespace {
+    // A peer that hangs up mid-write must fail the send, not raise SIGPIPE
+#ifdef MSG_NOSIGNAL
+    const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    const int SEND_FLAGS = 0;  // macOS sets SO_NOSIGPIPE on the socket instead; Windows has no SIGPIPE
+#endif
+
+    void closeSocket(std::intptr_t handle) {
+#ifdef _WIN32
+        closesocket(static_cast<SocketHandle>(handle));
+#else
+        ::close(static_cast<SocketHandle>(handle));
+#endif
+    }
+
+    bool sendAll(std::intptr_t handle, const std::string& data) {
+        std::size_t sent = 0;
+        while (sent < data.size()) {
+            int n = ::send(static_cast<SocketHandle>(handle), data.data() + sent, static_cast<int>(data.size() - sent), SEND_FLAGS);
+            if (n <= 0) return false;
+            sent += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+#ifdef _WIN32
+    struct WinsockInit {
+        WinsockInit() { WSADATA data; WSAStartup(MAKEWORD(2, 2), &data); }
+        ~WinsockInit() { WSACleanup(); }
+    };
+#endif
+}
+
+MetricsServer::MetricsServer(MetricsRegistry& registry, std::uint16_t port)
+    : registry(registry), listener(-1), port(port), stopping(false)
+{
+#ifdef _WIN32
+    static WinsockInit winsock;
+#endif
+    SocketHandle handle = ::socket(AF_INET, SOCK_STREAM, 0);
+#ifdef _WIN32
+    if (handle == INVALID_SOCKET) throw std::runtime_error("MetricsServer: cannot create socket");
+#else
+    if (handle < 0) throw std::runtime_error("MetricsServer: cannot create socket");
+#endif
+    listener = static_cast<std::intptr_t>(handle);
+
+    int reuse = 1;
+    ::setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (::bind(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(handle, 16) != 0) {
+        closeSocket(listener);
+        throw std::runtime_error("MetricsServer: cannot listen on 127.0.0.1:" + std::to_string(port));
+    }
+
+    socklen_t length = sizeof(address);
+    ::getsockname(handle, reinterpret_cast<sockaddr*>(&address), &length);
+    this->port = ntohs(address.sin_port);
+
+    worker = std::thread([this] { serveLoop(); });
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+void MetricsServer::stop() {
+    if (stopping.exchange(true)) return;
+    if (worker.joinable()) worker.join();
+    closeSocket(listener);
+}
+
+std::uint16_t MetricsServer::getPort() const {
+    return port;
+}
+
+void MetricsServer::serveLoop() {
+    // Poll with a timeout so stop() is noticed without tearing the socket down under accept
+    while (!stopping.load()) {
+        pollfd descriptor;
+        descriptor.fd = static_cast<SocketHandle>(listener);
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        if (pollSockets(&descriptor, 1, 200) <= 0) continue;
+
+        SocketHandle client = ::accept(static_cast<SocketHandle>(listener), nullptr, nullptr);
+#ifdef _WIN32
+        if (client == INVALID_SOCKET) continue;
+#else
+        if (client < 0) continue;
+#endif
+        // A stalled client, reading or writing, must not hold up the next scrape for long
+#ifdef _WIN32
+        DWORD timeout = 2000;
+#else
+        timeval timeout{2, 0};
+#endif
+        ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+        ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+        int noSigPipe = 1;
+        ::setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+        handleClient(static_cast<std::intptr_t>(client));
+        closeSocket(static_cast<std::intptr_t>(client));
+    }
+}
+
+void MetricsServer::handleClient(std::intptr_t client) {
+    // Only the request line matters; read until the end of the headers or 8 KiB
+    std::string request;
+    char buffer[1024];
+    while (request.size() < 8192 && request.find("\r\n\r\n") == std::string::npos) {
+        int n = ::recv(static_cast<SocketHandle>(client), buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        request.append(buffer, static_cast<std::size_t>(n));
+    }
+
+    std::string path;
+    if (request.compare(0, 4, "GET ") == 0) {
+        path = request.substr(4, request.find_first_of(" ?\r\n", 4) - 4);
+    }
+
+    std::string status;
+    std::string body;
+    if (path == "/metrics") {
+        status = "200 OK";
+        body = registry.toPrometheus();
+    } else {
+        status = "404 Not Found";
+        body = "Not Found\n";
+    }
+
+    sendAll(client, "HTTP/1.1 " + status + "\r\n"
+                    "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                    "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                    "Connection: close\r\n\r\n" + body);
+}
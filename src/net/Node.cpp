@@ -0,0 +1,617 @@
+#include "net/Node.h"
+#include "WireFormat.h"
+#include "utils/Hashing.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+using SocketHandle = SOCKET;
+#define pollSockets WSAPoll
+#define SHUTDOWN_BOTH SD_BOTH
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+using SocketHandle = int;
+#define pollSockets poll
+#define SHUTDOWN_BOTH SHUT_RDWR
+#endif
+
+namespace {
+    // A peer that hangs up mid-write must fail the send, not raise SIGPIPE
+#ifdef MSG_NOSIGNAL
+    const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    const int SEND_FLAGS = 0;  // macOS sets SO_NOSIGPIPE on the socket instead; Windows has no SIGPIPE
+#endif
+
+    void closeSocket(std::intptr_t handle) {
+#ifdef _WIN32
+        closesocket(static_cast<SocketHandle>(handle));
+#else
+        ::close(static_cast<SocketHandle>(handle));
+#endif
+    }
+
+    bool isValidSocket(SocketHandle handle) {
+#ifdef _WIN32
+        return handle != INVALID_SOCKET;
+#else
+        return handle >= 0;
+#endif
+    }
+
+    bool sendAll(std::intptr_t handle, const unsigned char* data, std::size_t size) {
+        std::size_t sent = 0;
+        while (sent < size) {
+            int n = ::send(static_cast<SocketHandle>(handle), reinterpret_cast<const char*>(data) + sent,
+                           static_cast<int>(size - sent), SEND_FLAGS);
+            if (n <= 0) return false;
+            sent += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    bool recvAll(std::intptr_t handle, unsigned char* data, std::size_t size) {
+        std::size_t received = 0;
+        while (received < size) {
+            int n = ::recv(static_cast<SocketHandle>(handle), reinterpret_cast<char*>(data) + received,
+                           static_cast<int>(size - received), 0);
+            if (n <= 0) return false;
+            received += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    sockaddr_in loopbackAddress(std::uint16_t port) {
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        return address;
+    }
+
+    std::shared_ptr<const std::vector<unsigned char>> makeMessage(MessageType type, const std::vector<unsigned char>& payload) {
+        return std::make_shared<const std::vector<unsigned char>>(Protocol::frame(type, payload));
+    }
+
+    bool isBlockTraffic(MessageType type) {
+        return type != MessageType::Transaction;
+    }
+
+#ifdef _WIN32
+    struct WinsockInit {
+        WinsockInit() { WSADATA data; WSAStartup(MAKEWORD(2, 2), &data); }
+        ~WinsockInit() { WSACleanup(); }
+    };
+#endif
+}
+
+struct Node::Peer {
+    std::intptr_t socket;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::shared_ptr<const std::vector<unsigned char>>> outbox;
+    bool closed = false;
+    std::thread reader;
+    std::thread writer;
+
+    explicit Peer(std::intptr_t socket) : socket(socket) {}
+
+    bool isClosed() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return closed;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (closed) return;
+            closed = true;
+        }
+        wake.notify_all();
+        // Unblocks the reader's recv; the handle itself is closed once both threads are gone
+        ::shutdown(static_cast<SocketHandle>(socket), SHUTDOWN_BOTH);
+    }
+};
+
+Node::Node(Blockchain& chain, const NodeOptions& options, std::uint16_t port)
+    : chain(chain), options(options), listener(-1), port(port), stopping(false),
+      bytesSent(0), bytesReceived(0), blockBytesSent(0), transactionBytesSent(0), blocksConnected(0),
+      compactBlocksReconstructed(0), transactionsRequested(0), fullBlockFallbacks(0), requestsAbandoned(0)
+{
+#ifdef _WIN32
+    static WinsockInit winsock;
+#endif
+    SocketHandle handle = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (!isValidSocket(handle)) throw std::runtime_error("Node: cannot create socket");
+    listener = static_cast<std::intptr_t>(handle);
+
+    int reuse = 1;
+    ::setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address = loopbackAddress(port);
+    if (::bind(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(handle, 64) != 0) {
+        closeSocket(listener);
+        throw std::runtime_error("Node: cannot listen on 127.0.0.1:" + std::to_string(port));
+    }
+
+    socklen_t length = sizeof(address);
+    ::getsockname(handle, reinterpret_cast<sockaddr*>(&address), &length);
+    this->port = ntohs(address.sin_port);
+
+    acceptor = std::thread([this] { acceptLoop(); });
+}
+
+Node::~Node() {
+    stop();
+}
+
+void Node::stop() {
+    if (stopping.exchange(true)) return;
+    if (acceptor.joinable()) acceptor.join();
+    closeSocket(listener);
+
+    std::vector<std::shared_ptr<Peer>> closing;
+    {
+        std::lock_guard<std::mutex> lock(peersMutex);
+        closing.swap(peers);
+    }
+    for (const auto& peer : closing) {
+        peer->close();
+        if (peer->reader.joinable()) peer->reader.join();
+        if (peer->writer.joinable()) peer->writer.join();
+        closeSocket(peer->socket);
+    }
+}
+
+std::uint16_t Node::getPort() const {
+    return port;
+}
+
+void Node::setBlockHandler(BlockHandler handler) {
+    blockHandler = std::move(handler);
+}
+
+std::size_t Node::getPeerCount() const {
+    std::lock_guard<std::mutex> lock(peersMutex);
+    return static_cast<std::size_t>(std::count_if(peers.begin(), peers.end(), [](const std::shared_ptr<Peer>& peer) {
+        return !peer->isClosed();
+    }));
+}
+
+NodeStats Node::getStats() const {
+    NodeStats stats;
+    stats.bytesSent = bytesSent.load();
+    stats.bytesReceived = bytesReceived.load();
+    stats.blockBytesSent = blockBytesSent.load();
+    stats.transactionBytesSent = transactionBytesSent.load();
+    stats.blocksConnected = blocksConnected.load();
+    stats.compactBlocksReconstructed = compactBlocksReconstructed.load();
+    stats.transactionsRequested = transactionsRequested.load();
+    stats.fullBlockFallbacks = fullBlockFallbacks.load();
+    stats.requestsAbandoned = requestsAbandoned.load();
+    return stats;
+}
+
+void Node::connect(std::uint16_t peerPort) {
+    SocketHandle handle = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (!isValidSocket(handle)) throw std::runtime_error("Node: cannot create socket");
+    sockaddr_in address = loopbackAddress(peerPort);
+    if (::connect(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        closeSocket(static_cast<std::intptr_t>(handle));
+        throw std::runtime_error("Node: cannot connect to 127.0.0.1:" + std::to_string(peerPort));
+    }
+    addPeer(static_cast<std::intptr_t>(handle));
+}
+
+void Node::acceptLoop() {
+    // Poll with a timeout so stop() is noticed without tearing the socket down under accept;
+    // the same tick reaps closed peers and expires stale requests and orphans
+    while (!stopping.load()) {
+        reapPeers();
+        expireStale();
+        pollfd descriptor;
+        descriptor.fd = static_cast<SocketHandle>(listener);
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        if (pollSockets(&descriptor, 1, 200) <= 0) continue;
+
+        SocketHandle client = ::accept(static_cast<SocketHandle>(listener), nullptr, nullptr);
+        if (!isValidSocket(client)) continue;
+        addPeer(static_cast<std::intptr_t>(client));
+    }
+}
+
+void Node::addPeer(std::intptr_t socket) {
+    // Relay messages are small and latency-bound; do not let Nagle hold them back
+    int noDelay = 1;
+    ::setsockopt(static_cast<SocketHandle>(socket), IPPROTO_TCP, TCP_NODELAY,
+                 reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+
+    // A peer that stops reading is dropped once its socket buffer stays full this long
+#ifdef _WIN32
+    DWORD timeout = 10000;
+#else
+    timeval timeout{10, 0};
+#endif
+    ::setsockopt(static_cast<SocketHandle>(socket), SOL_SOCKET, SO_SNDTIMEO,
+                 reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+    int noSigPipe = 1;
+    ::setsockopt(static_cast<SocketHandle>(socket), SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+    auto peer = std::make_shared<Peer>(socket);
+    std::lock_guard<std::mutex> lock(peersMutex);
+    if (stopping.load()) {
+        closeSocket(socket);
+        return;
+    }
+    peer->reader = std::thread([this, peer] { readLoop(peer); });
+    peer->writer = std::thread([this, peer] { writeLoop(peer); });
+    peers.push_back(peer);
+}
+
+void Node::reapPeers() {
+    std::vector<std::shared_ptr<Peer>> closed;
+    {
+        std::lock_guard<std::mutex> lock(peersMutex);
+        auto open = std::stable_partition(peers.begin(), peers.end(), [](const std::shared_ptr<Peer>& peer) {
+            return !peer->isClosed();
+        });
+        closed.assign(open, peers.end());
+        peers.erase(open, peers.end());
+    }
+    // Both threads return promptly once a peer is closed: the socket is shut down and the
+    // writer is woken. Only this thread and stop() join them, and stop() joins this one first.
+    for (const auto& peer : closed) {
+        if (peer->reader.joinable()) peer->reader.join();
+        if (peer->writer.joinable()) peer->writer.join();
+        closeSocket(peer->socket);
+    }
+}
+
+void Node::readLoop(const std::shared_ptr<Peer>& peer) {
+    std::vector<unsigned char> payload;
+    unsigned char header[Protocol::FRAME_HEADER_SIZE];
+    while (recvAll(peer->socket, header, sizeof(header))) {
+        std::size_t length = 0;
+        for (int i = 0; i < 4; ++i) length |= static_cast<std::size_t>(header[1 + i]) << (8 * i);
+        if (length > Protocol::MAX_PAYLOAD_SIZE) break;
+        payload.resize(length);
+        if (!recvAll(peer->socket, payload.data(), length)) break;
+        bytesReceived += Protocol::FRAME_HEADER_SIZE + length;
+
+        // A malformed message ends the connection; nothing it carried has been applied
+        try {
+            handleMessage(peer, static_cast<MessageType>(header[0]), payload);
+        } catch (const std::exception&) {
+            break;
+        }
+    }
+    peer->close();
+
+    // Nothing more will arrive from it; fetch what it owed us from someone else
+    abandonRequests([&](const PendingBlock& block) { return block.source == peer; });
+}
+
+void Node::writeLoop(const std::shared_ptr<Peer>& peer) {
+    for (;;) {
+        std::shared_ptr<const std::vector<unsigned char>> message;
+        {
+            std::unique_lock<std::mutex> lock(peer->mutex);
+            peer->wake.wait(lock, [&] { return peer->closed || !peer->outbox.empty(); });
+            if (peer->closed) return;
+            message = std::move(peer->outbox.front());
+            peer->outbox.pop_front();
+        }
+        if (!sendAll(peer->socket, message->data(), message->size())) {
+            peer->close();
+            return;
+        }
+        bytesSent += message->size();
+        if (isBlockTraffic(static_cast<MessageType>((*message)[0]))) {
+            blockBytesSent += message->size();
+        } else {
+            transactionBytesSent += message->size();
+        }
+    }
+}
+
+void Node::send(const std::shared_ptr<Peer>& peer, std::shared_ptr<const std::vector<unsigned char>> message) {
+    {
+        std::lock_guard<std::mutex> lock(peer->mutex);
+        if (peer->closed) return;
+        peer->outbox.push_back(std::move(message));
+    }
+    peer->wake.notify_one();
+}
+
+void Node::broadcast(std::shared_ptr<const std::vector<unsigned char>> message, const Peer* except) {
+    std::vector<std::shared_ptr<Peer>> targets;
+    {
+        std::lock_guard<std::mutex> lock(peersMutex);
+        targets = peers;
+    }
+    // Every peer queues the same encoded frame; send() skips peers closed but not yet reaped
+    for (const auto& peer : targets) {
+        if (peer.get() != except) send(peer, message);
+    }
+}
+
+bool Node::submitTransaction(const Transaction& tx) {
+    if (!chain.addTransaction(tx)) return false;
+    broadcast(makeMessage(MessageType::Transaction, WireFormat::encode(tx)), nullptr);
+    return true;
+}
+
+bool Node::submitBlock(const Block& block) {
+    return connectBlock(block, nullptr);
+}
+
+void Node::handleMessage(const std::shared_ptr<Peer>& peer, MessageType type, const std::vector<unsigned char>& payload) {
+    switch (type) {
+        case MessageType::Transaction:
+            handleTransaction(peer, WireFormat::decodeTransaction(payload.data(), payload.size()));
+            break;
+        case MessageType::Block: {
+            Block block = WireFormat::decodeBlock(payload.data(), payload.size());
+            size_t height;
+            if (!chain.findBlockHeight(block.getHash(), height)) connectBlock(block, peer.get());
+            break;
+        }
+        case MessageType::CompactBlock:
+            handleCompactBlock(peer, CompactBlock::decode(payload.data(), payload.size()));
+            break;
+        case MessageType::GetBlockTransactions:
+            serveBlockTransactions(peer, BlockTransactionsRequest::decode(payload.data(), payload.size()));
+            break;
+        case MessageType::BlockTransactions:
+            handleBlockTransactions(peer, BlockTransactions::decode(payload.data(), payload.size()));
+            break;
+        case MessageType::GetBlock: {
+            if (payload.size() != Hash256::SIZE) throw std::runtime_error("Node: malformed GetBlock");
+            Hash256 hash;
+            std::memcpy(hash.data(), payload.data(), Hash256::SIZE);
+            serveBlock(peer, hash);
+            break;
+        }
+        default:
+            throw std::runtime_error("Node: unknown message type");
+    }
+}
+
+void Node::handleTransaction(const std::shared_ptr<Peer>& peer, const Transaction& tx) {
+    // Already pending or confirmed: the flood has been here before
+    Hash256 id = tx.getId();
+    TransactionLocation location;
+    if (chain.getMempool()->contains(id) || chain.findTransaction(id, location)) return;
+    if (chain.addTransaction(tx)) {
+        broadcast(makeMessage(MessageType::Transaction, WireFormat::encode(tx)), peer.get());
+    }
+}
+
+void Node::handleCompactBlock(const std::shared_ptr<Peer>& peer, const CompactBlock& compact) {
+    Hash256 hash = Hashing::sha256(compact.header.bytes, BlockHeader::SIZE);
+    size_t height;
+    if (chain.findBlockHeight(hash, height)) return;
+    {
+        // Copies from other peers are dropped while one is being rebuilt; their senders
+        // are remembered in case the first one never delivers
+        std::lock_guard<std::mutex> lock(blocksMutex);
+        if (!inFlight.insert(hash).second) {
+            auto it = pending.find(hash);
+            if (it != pending.end() && it->second.source != peer) it->second.alternates.push_back(peer);
+            return;
+        }
+    }
+
+    // Match short ids against the mempool's cached ids; a colliding pair is left for validation to catch
+    std::uint64_t key = Protocol::shortIdKey(hash);
+    std::unordered_map<std::uint64_t, Transaction> byShortId;
+    chain.getMempool()->forEach([&](const Hash256& id, const Transaction& tx) {
+        byShortId.emplace(Protocol::shortId(id, key), tx);
+    });
+
+    std::size_t count = compact.getTransactionCount();
+    std::vector<Transaction> transactions(count, Transaction(Hash256{}, Hash256{}, 0, 0, 0, Signature{}));
+    std::vector<std::size_t> missing;
+    std::size_t nextPrefilled = 0;
+    std::size_t nextShortId = 0;
+    for (std::size_t position = 0; position < count; ++position) {
+        if (nextPrefilled < compact.prefilled.size() && compact.prefilled[nextPrefilled].first == position) {
+            transactions[position] = compact.prefilled[nextPrefilled++].second;
+            continue;
+        }
+        auto it = byShortId.find(compact.shortIds[nextShortId++]);
+        if (it != byShortId.end()) {
+            transactions[position] = it->second;
+        } else {
+            missing.push_back(position);
+        }
+    }
+
+    if (missing.empty()) {
+        if (completeBlock(peer, hash, compact.header, transactions)) ++compactBlocksReconstructed;
+        return;
+    }
+
+    transactionsRequested += missing.size();
+    BlockTransactionsRequest request{hash, missing};
+    {
+        std::lock_guard<std::mutex> lock(blocksMutex);
+        pending.emplace(hash, PendingBlock{compact.header, std::move(transactions), std::move(missing), peer,
+                                           std::chrono::steady_clock::now(), {}});
+    }
+    send(peer, makeMessage(MessageType::GetBlockTransactions, request.encode()));
+}
+
+void Node::handleBlockTransactions(const std::shared_ptr<Peer>& peer, const BlockTransactions& response) {
+    std::unique_lock<std::mutex> lock(blocksMutex);
+    auto it = pending.find(response.blockHash);
+    if (it == pending.end() || it->second.source != peer) return;
+    PendingBlock block = std::move(it->second);
+    pending.erase(it);
+    lock.unlock();
+
+    if (response.transactions.size() != block.missing.size()) {
+        lock.lock();
+        inFlight.erase(response.blockHash);
+        lock.unlock();
+        fetchElsewhere(response.blockHash, block);
+        throw std::runtime_error("Node: BlockTransactions does not match the request");
+    }
+    for (std::size_t i = 0; i < block.missing.size(); ++i) {
+        block.transactions[block.missing[i]] = response.transactions[i];
+    }
+    completeBlock(peer, response.blockHash, block.header, block.transactions);
+}
+
+void Node::serveBlockTransactions(const std::shared_ptr<Peer>& peer, const BlockTransactionsRequest& request) {
+    size_t height;
+    if (!chain.findBlockHeight(request.blockHash, height)) return;
+    Block block = chain.getBlock(height);
+    const TransactionColumns& transactions = block.getTransactions();
+
+    BlockTransactions response;
+    response.blockHash = request.blockHash;
+    response.transactions.reserve(request.positions.size());
+    for (std::size_t position : request.positions) {
+        if (position >= transactions.size()) throw std::runtime_error("Node: requested position past the block");
+        response.transactions.push_back(transactions[position]);
+    }
+    send(peer, makeMessage(MessageType::BlockTransactions, response.encode()));
+}
+
+void Node::serveBlock(const std::shared_ptr<Peer>& peer, const Hash256& hash) {
+    size_t height;
+    if (!chain.findBlockHeight(hash, height)) return;
+    send(peer, makeMessage(MessageType::Block, WireFormat::encode(chain.getBlock(height))));
+}
+
+void Node::abandonRequests(const std::function<bool(const PendingBlock&)>& abandon) {
+    std::vector<std::pair<Hash256, PendingBlock>> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(blocksMutex);
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (!abandon(it->second)) {
+                ++it;
+                continue;
+            }
+            inFlight.erase(it->first);
+            abandoned.emplace_back(it->first, std::move(it->second));
+            it = pending.erase(it);
+        }
+    }
+    for (const auto& entry : abandoned) {
+        ++requestsAbandoned;
+        fetchElsewhere(entry.first, entry.second);
+    }
+}
+
+void Node::fetchElsewhere(const Hash256& hash, const PendingBlock& block) {
+    auto request = makeMessage(MessageType::GetBlock, std::vector<unsigned char>(hash.bytes.begin(), hash.bytes.end()));
+    for (const auto& candidate : block.alternates) {
+        std::shared_ptr<Peer> alternate = candidate.lock();
+        if (alternate && !alternate->isClosed()) {
+            send(alternate, request);
+            return;
+        }
+    }
+    // Nobody else announced it yet; peers that do not have it ignore the request
+    broadcast(request, block.source.get());
+}
+
+void Node::expireStale() {
+    auto now = std::chrono::steady_clock::now();
+    abandonRequests([&](const PendingBlock& block) { return now - block.requested >= options.requestTimeout; });
+
+    std::lock_guard<std::mutex> lock(blocksMutex);
+    for (auto it = orphans.begin(); it != orphans.end();) {
+        if (now - it->second.received >= options.orphanExpiry) {
+            it = orphans.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool Node::completeBlock(const std::shared_ptr<Peer>& peer, const Hash256& hash, const BlockHeader& header,
+                         const std::vector<Transaction>& transactions) {
+    Block block(header, TransactionColumns(transactions));
+    bool connected = connectBlock(block, peer.get());
+    {
+        std::lock_guard<std::mutex> lock(blocksMutex);
+        inFlight.erase(hash);
+    }
+    if (connected) return true;
+
+    size_t height;
+    if (!chain.findBlockHeight(hash, height) &&
+        block.getPreviousHash() == chain.getSnapshot()->getLatestBlock().getHash()) {
+        // It extends our tip yet fails validation: most likely a short id collision
+        ++fullBlockFallbacks;
+        send(peer, makeMessage(MessageType::GetBlock, std::vector<unsigned char>(hash.bytes.begin(), hash.bytes.end())));
+    }
+    return false;
+}
+
+bool Node::connectBlock(const Block& block, const Peer* source) {
+    if (!chain.submitBlock(block)) {
+        // Its parent may still be in flight on another connection; hold it until then
+        std::shared_ptr<const ChainSnapshot> tip = chain.getSnapshot();
+        if (source && static_cast<std::size_t>(block.getIndex()) > tip->getBlockCount()) {
+            std::lock_guard<std::mutex> lock(blocksMutex);
+            if (options.maxOrphans == 0 || orphans.count(block.getPreviousHash())) return false;
+            if (orphans.size() >= options.maxOrphans) {
+                // Newer blocks are likelier to connect than ones whose parent has been missing longer
+                orphans.erase(std::min_element(orphans.begin(), orphans.end(), [](const auto& a, const auto& b) {
+                    return a.second.received < b.second.received;
+                }));
+            }
+            orphans.emplace(block.getPreviousHash(), Orphan{block, std::chrono::steady_clock::now()});
+        }
+        return false;
+    }
+
+    if (source) {
+        ++blocksConnected;
+        if (blockHandler) blockHandler(block);
+    }
+    announce(block, source);
+
+    // Connect any orphans that were waiting for this block
+    for (Hash256 parent = block.getHash();;) {
+        std::unique_lock<std::mutex> lock(blocksMutex);
+        auto it = orphans.find(parent);
+        if (it == orphans.end()) return true;
+        Block child = std::move(it->second.block);
+        orphans.erase(it);
+        lock.unlock();
+
+        if (!chain.submitBlock(child)) return true;
+        ++blocksConnected;
+        if (blockHandler) blockHandler(child);
+        announce(child, nullptr);
+        parent = child.getHash();
+    }
+}
+
+void Node::announce(const Block& block, const Peer* except) {
+    if (options.compactBlocks) {
+        broadcast(makeMessage(MessageType::CompactBlock, CompactBlock::fromBlock(block).encode()), except);
+    } else {
+        broadcast(makeMessage(MessageType::Block, WireFormat::encode(block)), except);
+    }
+}
@@ -0,0 +1,197 @@
+#include "net/Protocol.h"
+#include "WireFormat.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    void appendVarint(std::vector<unsigned char>& out, std::uint64_t value) {
+        unsigned char buffer[WireFormat::MAX_VARINT_SIZE];
+        out.insert(out.end(), buffer, WireFormat::putVarint(buffer, value));
+    }
+
+    void appendTransaction(std::vector<unsigned char>& out, const Transaction& tx) {
+        unsigned char buffer[WireFormat::MAX_TRANSACTION_SIZE];
+        out.insert(out.end(), buffer, WireFormat::encode(tx, buffer));
+    }
+
+    const unsigned char* readHash(const unsigned char* cursor, const unsigned char* end, Hash256& hash) {
+        if (static_cast<std::size_t>(end - cursor) < Hash256::SIZE) {
+            throw std::runtime_error("Protocol: truncated message");
+        }
+        std::memcpy(hash.data(), cursor, Hash256::SIZE);
+        return cursor + Hash256::SIZE;
+    }
+
+    // Counts are checked against the bytes left before anything is reserved for them
+    std::size_t readCount(const unsigned char*& cursor, const unsigned char* end, std::size_t minimumItemSize) {
+        std::uint64_t count = WireFormat::readVarint(cursor, end);
+        if (count > static_cast<std::uint64_t>(end - cursor) / minimumItemSize) {
+            throw std::runtime_error("Protocol: count exceeds message size");
+        }
+        return static_cast<std::size_t>(count);
+    }
+
+    // Positions are sent as gaps from the previous one, so dense requests stay one byte each
+    void appendPositions(std::vector<unsigned char>& out, const std::vector<std::size_t>& positions) {
+        appendVarint(out, positions.size());
+        std::size_t next = 0;
+        for (std::size_t position : positions) {
+            appendVarint(out, position - next);
+            next = position + 1;
+        }
+    }
+
+    std::size_t readPosition(const unsigned char*& cursor, const unsigned char* end, std::size_t& next) {
+        std::uint64_t gap = WireFormat::readVarint(cursor, end);
+        if (gap > Protocol::MAX_PAYLOAD_SIZE) throw std::runtime_error("Protocol: position out of range");
+        std::size_t position = next + static_cast<std::size_t>(gap);
+        next = position + 1;
+        return position;
+    }
+
+    void expectEnd(const unsigned char* cursor, const unsigned char* end) {
+        if (cursor != end) throw std::runtime_error("Protocol: trailing bytes in message");
+    }
+}
+
+std::vector<unsigned char> Protocol::frame(MessageType type, const std::vector<unsigned char>& payload) {
+    if (payload.size() > MAX_PAYLOAD_SIZE) throw std::runtime_error("Protocol: message too large");
+    std::vector<unsigned char> out;
+    out.reserve(FRAME_HEADER_SIZE + payload.size());
+    out.push_back(static_cast<unsigned char>(type));
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<unsigned char>(payload.size() >> (8 * i)));
+    out.insert(out.end(), payload.begin(), payload.end());
+    return out;
+}
+
+std::uint64_t Protocol::shortIdKey(const Hash256& blockHash) {
+    std::uint64_t key;
+    std::memcpy(&key, blockHash.data() + Hash256::SIZE - sizeof(key), sizeof(key));
+    return key;
+}
+
+std::uint64_t Protocol::shortId(const Hash256& txId, std::uint64_t key) {
+    // Ids are already uniform; the splitmix64 finalizer spreads the salt over every bit
+    std::uint64_t value;
+    std::memcpy(&value, txId.data(), sizeof(value));
+    value ^= key;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value & ((std::uint64_t(1) << (8 * SHORT_ID_SIZE)) - 1);
+}
+
+CompactBlock::CompactBlock(const BlockHeader& header) : header(header) {}
+
+CompactBlock CompactBlock::fromBlock(const Block& block) {
+    CompactBlock compact(block.getHeader());
+    std::uint64_t key = Protocol::shortIdKey(block.getHash());
+    const TransactionColumns& transactions = block.getTransactions();
+    compact.shortIds.reserve(transactions.size());
+    for (std::size_t i = 0; i < transactions.size(); ++i) {
+        Transaction tx = transactions[i];
+        if (tx.isReward()) {
+            compact.prefilled.emplace_back(i, tx);
+        } else {
+            compact.shortIds.push_back(Protocol::shortId(tx.getId(), key));
+        }
+    }
+    return compact;
+}
+
+std::size_t CompactBlock::getTransactionCount() const {
+    return prefilled.size() + shortIds.size();
+}
+
+// header | varint prefilled count | (position gap, transaction)* | varint short id count | 6-byte ids
+std::vector<unsigned char> CompactBlock::encode() const {
+    std::vector<unsigned char> out(WireFormat::HEADER_SIZE);
+    WireFormat::encodeHeader(header, out.data());
+    out.reserve(out.size() + prefilled.size() * WireFormat::MAX_TRANSACTION_SIZE +
+                shortIds.size() * Protocol::SHORT_ID_SIZE + 2 * WireFormat::MAX_VARINT_SIZE);
+
+    appendVarint(out, prefilled.size());
+    std::size_t next = 0;
+    for (const auto& entry : prefilled) {
+        appendVarint(out, entry.first - next);
+        next = entry.first + 1;
+        appendTransaction(out, entry.second);
+    }
+
+    appendVarint(out, shortIds.size());
+    for (std::uint64_t id : shortIds) {
+        for (std::size_t i = 0; i < Protocol::SHORT_ID_SIZE; ++i) out.push_back(static_cast<unsigned char>(id >> (8 * i)));
+    }
+    return out;
+}
+
+CompactBlock CompactBlock::decode(const unsigned char* data, std::size_t size) {
+    const unsigned char* end = data + size;
+    CompactBlock compact(WireFormat::decodeHeader(data, size));
+    const unsigned char* cursor = data + WireFormat::HEADER_SIZE;
+
+    std::size_t prefilledCount = readCount(cursor, end, 2);
+    std::size_t next = 0;
+    TransactionView tx;
+    for (std::size_t i = 0; i < prefilledCount; ++i) {
+        std::size_t position = readPosition(cursor, end, next);
+        cursor = tx.parse(cursor, end);
+        compact.prefilled.emplace_back(position, tx.toTransaction());
+    }
+
+    std::size_t idCount = readCount(cursor, end, Protocol::SHORT_ID_SIZE);
+    compact.shortIds.reserve(idCount);
+    for (std::size_t i = 0; i < idCount; ++i, cursor += Protocol::SHORT_ID_SIZE) {
+        std::uint64_t id = 0;
+        for (std::size_t b = 0; b < Protocol::SHORT_ID_SIZE; ++b) id |= static_cast<std::uint64_t>(cursor[b]) << (8 * b);
+        compact.shortIds.push_back(id);
+    }
+    expectEnd(cursor, end);
+
+    if (!compact.prefilled.empty() && compact.prefilled.back().first >= compact.getTransactionCount()) {
+        throw std::runtime_error("Protocol: prefilled position past the block's transactions");
+    }
+    return compact;
+}
+
+std::vector<unsigned char> BlockTransactionsRequest::encode() const {
+    std::vector<unsigned char> out(blockHash.bytes.begin(), blockHash.bytes.end());
+    appendPositions(out, positions);
+    return out;
+}
+
+BlockTransactionsRequest BlockTransactionsRequest::decode(const unsigned char* data, std::size_t size) {
+    const unsigned char* end = data + size;
+    BlockTransactionsRequest request;
+    const unsigned char* cursor = readHash(data, end, request.blockHash);
+    std::size_t count = readCount(cursor, end, 1);
+    request.positions.reserve(count);
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        request.positions.push_back(readPosition(cursor, end, next));
+    }
+    expectEnd(cursor, end);
+    return request;
+}
+
+std::vector<unsigned char> BlockTransactions::encode() const {
+    std::vector<unsigned char> out(blockHash.bytes.begin(), blockHash.bytes.end());
+    appendVarint(out, transactions.size());
+    for (const auto& tx : transactions) appendTransaction(out, tx);
+    return out;
+}
+
+BlockTransactions BlockTransactions::decode(const unsigned char* data, std::size_t size) {
+    const unsigned char* end = data + size;
+    BlockTransactions response;
+    const unsigned char* cursor = readHash(data, end, response.blockHash);
+    std::size_t count = readCount(cursor, end, 1 + Hash256::SIZE + 3);
+    response.transactions.reserve(count);
+    TransactionView tx;
+    for (std::size_t i = 0; i < count; ++i) {
+        cursor = tx.parse(cursor, end);
+        response.transactions.push_back(tx.toTransaction());
+    }
+    expectEnd(cursor, end);
+    return response;
+}
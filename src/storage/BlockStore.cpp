@@ -0,0 +1,277 @@
+#include "storage/BlockStore.h"
+#include "WireFormat.h"
+#include "utils/Hashing.h"
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    const char INDEX_MAGIC[8] = {'M', 'B', 'I', 'D', 'X', '0', '0', '6'};
+    const std::size_t INDEX_HEADER_SIZE = sizeof(INDEX_MAGIC) + 4;  // Magic, then the i32 difficulty
+    const std::size_t INDEX_CHECKSUM_SIZE = 4;
+    const std::size_t INDEX_PAYLOAD_SIZE = 4 + 8 + 4 + 4 + BlockHeader::SIZE + Hash256::SIZE;
+    const std::size_t INDEX_RECORD_SIZE = INDEX_PAYLOAD_SIZE + INDEX_CHECKSUM_SIZE;
+
+    // Leading bytes of the SHA-256 of the record's fields
+    void putChecksum(std::vector<unsigned char>& out, const unsigned char* payload) {
+        Hash256 digest = Hashing::sha256(payload, INDEX_PAYLOAD_SIZE);
+        out.insert(out.end(), digest.data(), digest.data() + INDEX_CHECKSUM_SIZE);
+    }
+
+    bool checksumMatches(const unsigned char* record) {
+        Hash256 digest = Hashing::sha256(record, INDEX_PAYLOAD_SIZE);
+        return std::memcmp(digest.data(), record + INDEX_PAYLOAD_SIZE, INDEX_CHECKSUM_SIZE) == 0;
+    }
+
+    void putLE(std::vector<unsigned char>& out, std::uint64_t value, std::size_t width) {
+        for (std::size_t i = 0; i < width; ++i) {
+            out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+    std::uint64_t getLE(const unsigned char* in, std::size_t width) {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < width; ++i) {
+            value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    void syncFile(std::FILE* file) {
+        std::fflush(file);
+#ifdef _WIN32
+        _commit(_fileno(file));
+#else
+        ::fsync(fileno(file));
+#endif
+    }
+}
+
+BlockStore::BlockStore(const std::string& directory, const BlockStoreOptions& options)
+    : directory(directory), options(options), difficulty(-1), indexFile(nullptr), tailOffset(0), unsyncedOffset(0),
+      unsyncedBlocks(0)
+{
+    std::filesystem::create_directories(directory);
+    loadIndex();
+}
+
+BlockStore::~BlockStore() {
+    try {
+        syncPending();
+    } catch (const std::exception&) {
+        // Unsynced blocks are lost, as after a crash; the index on disk stays consistent
+    }
+    if (indexFile) {
+        std::fclose(indexFile);
+    }
+}
+
+std::string BlockStore::segmentPath(std::uint32_t segment) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "segment-%05u.dat", static_cast<unsigned int>(segment));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+void BlockStore::loadIndex() {
+    std::string indexPath = (std::filesystem::path(directory) / "blocks.idx").string();
+
+    std::uintmax_t fileSize = std::filesystem::exists(indexPath) ? std::filesystem::file_size(indexPath) : 0;
+    if (fileSize < INDEX_HEADER_SIZE) {
+        indexFile = std::fopen(indexPath.c_str(), "wb+");
+        if (!indexFile) throw std::runtime_error("BlockStore: cannot create " + indexPath);
+        std::vector<unsigned char> header(INDEX_MAGIC, INDEX_MAGIC + sizeof(INDEX_MAGIC));
+        putLE(header, static_cast<std::uint32_t>(difficulty), 4);
+        std::fwrite(header.data(), 1, header.size(), indexFile);
+        syncFile(indexFile);
+        return;
+    }
+
+    std::FILE* in = std::fopen(indexPath.c_str(), "rb");
+    if (!in) throw std::runtime_error("BlockStore: cannot open " + indexPath);
+    unsigned char header[INDEX_HEADER_SIZE];
+    if (std::fread(header, 1, sizeof(header), in) != sizeof(header) ||
+        std::memcmp(header, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0) {
+        std::fclose(in);
+        throw std::runtime_error("BlockStore: " + indexPath + " is not a block index");
+    }
+    difficulty = static_cast<int>(static_cast<std::int32_t>(getLE(header + sizeof(INDEX_MAGIC), 4)));
+
+    // Records are trusted up to the first torn or corrupt one; everything after it is dropped
+    std::uintmax_t records = (fileSize - INDEX_HEADER_SIZE) / INDEX_RECORD_SIZE;
+    entries.reserve(static_cast<std::size_t>(records));
+    heightByHash.reserve(static_cast<std::size_t>(records));
+    unsigned char record[INDEX_RECORD_SIZE];
+    while (std::fread(record, 1, INDEX_RECORD_SIZE, in) == INDEX_RECORD_SIZE && checksumMatches(record)) {
+        IndexEntry entry{
+            static_cast<std::uint32_t>(getLE(record, 4)),
+            getLE(record + 4, 8),
+            static_cast<std::uint32_t>(getLE(record + 12, 4)),
+            static_cast<std::uint32_t>(getLE(record + 16, 4)),
+            BlockHeader::fromBytes(record + 20),
+            Hash256{}
+        };
+        std::memcpy(entry.hash.data(), record + 20 + BlockHeader::SIZE, Hash256::SIZE);
+        heightByHash[entry.hash] = entries.size();
+        entries.push_back(entry);
+    }
+    std::fclose(in);
+
+    std::uintmax_t validSize = INDEX_HEADER_SIZE + entries.size() * INDEX_RECORD_SIZE;
+    if (validSize != fileSize) {
+        std::filesystem::resize_file(indexPath, validSize);
+    }
+
+    indexFile = std::fopen(indexPath.c_str(), "rb+");
+    if (!indexFile) throw std::runtime_error("BlockStore: cannot open " + indexPath);
+    std::fseek(indexFile, 0, SEEK_END);
+
+    if (!entries.empty()) {
+        const IndexEntry& last = entries.back();
+        for (std::uint32_t segment = 0; segment <= last.segment; ++segment) {
+            openSegment(segment, 0);
+        }
+        tailOffset = last.offset + last.length;
+        unsyncedOffset = tailOffset;
+    }
+}
+
+void BlockStore::openSegment(std::uint32_t segment, std::size_t minimumSize) {
+    segments.push_back(std::make_unique<MappedFile>(segmentPath(segment), minimumSize));
+}
+
+void BlockStore::append(const Block& block) {
+    std::size_t recordSize = WireFormat::encodedSize(block);
+
+    // Roll over to a new segment when the record does not fit; oversized blocks get a segment of their own
+    if (segments.empty() || tailOffset + recordSize > segments.back()->size()) {
+        syncPending();
+        openSegment(static_cast<std::uint32_t>(segments.size()),
+                    recordSize > options.segmentSize ? recordSize : options.segmentSize);
+        tailOffset = 0;
+        unsyncedOffset = 0;
+    }
+
+    // Encoded straight into the mapping, no intermediate buffer
+    std::uint32_t segment = static_cast<std::uint32_t>(segments.size() - 1);
+    WireFormat::encode(block, segments.back()->data() + tailOffset);
+
+    IndexEntry entry{segment, tailOffset, static_cast<std::uint32_t>(recordSize),
+                     static_cast<std::uint32_t>(block.getTransactionCount()), block.getHeader(), block.getHash()};
+
+    // Held back until syncPending() has made the segment bytes durable
+    std::size_t recordStart = pendingIndex.size();
+    putLE(pendingIndex, entry.segment, 4);
+    putLE(pendingIndex, entry.offset, 8);
+    putLE(pendingIndex, entry.length, 4);
+    putLE(pendingIndex, entry.txCount, 4);
+    pendingIndex.insert(pendingIndex.end(), entry.header.bytes, entry.header.bytes + BlockHeader::SIZE);
+    pendingIndex.insert(pendingIndex.end(), entry.hash.data(), entry.hash.data() + Hash256::SIZE);
+    putChecksum(pendingIndex, pendingIndex.data() + recordStart);
+
+    tailOffset += recordSize;
+    heightByHash[entry.hash] = entries.size();
+    entries.push_back(entry);
+
+    ++unsyncedBlocks;
+    if (options.syncInterval > 0 && unsyncedBlocks >= options.syncInterval) {
+        syncPending();
+    }
+}
+
+void BlockStore::sync() {
+    syncPending();
+}
+
+void BlockStore::syncPending() {
+    if (unsyncedBlocks == 0) return;
+    // Segment data first, then the index records that commit it
+    segments.back()->sync(static_cast<std::size_t>(unsyncedOffset), static_cast<std::size_t>(tailOffset - unsyncedOffset));
+    if (std::fwrite(pendingIndex.data(), 1, pendingIndex.size(), indexFile) != pendingIndex.size()) {
+        throw std::runtime_error("BlockStore: failed to write block index");
+    }
+    syncFile(indexFile);
+    pendingIndex.clear();
+    unsyncedOffset = tailOffset;
+    unsyncedBlocks = 0;
+}
+
+int BlockStore::getDifficulty() const {
+    return difficulty;
+}
+
+void BlockStore::setDifficulty(int value) {
+    if (value == difficulty) return;
+    // Rewritten in place; pending index records are still buffered, so the append
+    // position is only moved away and back
+    std::vector<unsigned char> bytes;
+    putLE(bytes, static_cast<std::uint32_t>(value), 4);
+    if (std::fseek(indexFile, static_cast<long>(sizeof(INDEX_MAGIC)), SEEK_SET) != 0 ||
+        std::fwrite(bytes.data(), 1, bytes.size(), indexFile) != bytes.size()) {
+        std::fseek(indexFile, 0, SEEK_END);
+        throw std::runtime_error("BlockStore: failed to write the difficulty");
+    }
+    syncFile(indexFile);
+    std::fseek(indexFile, 0, SEEK_END);
+    difficulty = value;
+}
+
+std::size_t BlockStore::size() const {
+    return entries.size();
+}
+
+const BlockHeader& BlockStore::getHeader(std::size_t height) const {
+    return entries.at(height).header;
+}
+
+const Hash256& BlockStore::getHash(std::size_t height) const {
+    return entries.at(height).hash;
+}
+
+std::size_t BlockStore::getTransactionCount(std::size_t height) const {
+    return entries.at(height).txCount;
+}
+
+bool BlockStore::findHeight(const Hash256& hash, std::size_t& height) const {
+    auto it = heightByHash.find(hash);
+    if (it == heightByHash.end()) return false;
+    height = it->second;
+    return true;
+}
+
+BlockStore::BlockView BlockStore::view(std::size_t height) const {
+    const IndexEntry& entry = entries.at(height);
+    return BlockView{segments[entry.segment]->data() + entry.offset, entry.length};
+}
+
+Block BlockStore::readBlock(std::size_t height) const {
+    BlockView record = view(height);
+    return WireFormat::decodeBlock(record.data, record.size);
+}
+
+Transaction BlockStore::readTransaction(std::size_t height, std::size_t position) const {
+    BlockView record = view(height);
+    BlockReader reader(record.data, record.size);
+    if (position >= reader.getTransactionCount()) {
+        throw std::out_of_range("BlockStore::readTransaction: position past the block's transactions");
+    }
+    // Rows are variable-length, so skip to the one wanted; skipping only parses three varints per row
+    TransactionView tx;
+    for (std::size_t i = 0; i <= position; ++i) reader.next(tx);
+    return tx.toTransaction();
+}
+
+void BlockStore::forEachTransfer(std::size_t height,
+                                 const std::function<void(const Hash256&, const Hash256&, Amount, Amount)>& visit) const {
+    BlockView record = view(height);
+    BlockReader reader(record.data, record.size);
+    TransactionView tx;
+    while (reader.next(tx)) {
+        visit(tx.getSender(), tx.getReceiver(), tx.getAmount(), tx.getFee());
+    }
+}
@@ -0,0 +1,100 @@
+#include "storage/MappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path, std::size_t minimumSize)
+    : fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr), mapping(nullptr), length(0)
+{
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                             OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("MappedFile: cannot open " + path);
+    }
+
+    LARGE_INTEGER current;
+    GetFileSizeEx(fileHandle, &current);
+    length = static_cast<std::size_t>(current.QuadPart) < minimumSize ? minimumSize : static_cast<std::size_t>(current.QuadPart);
+
+    LARGE_INTEGER mapSize;
+    mapSize.QuadPart = static_cast<LONGLONG>(length);
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READWRITE, mapSize.HighPart, mapSize.LowPart, nullptr);
+    if (!mappingHandle) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("MappedFile: cannot map " + path);
+    }
+
+    mapping = static_cast<unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, length));
+    if (!mapping) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw std::runtime_error("MappedFile: cannot map " + path);
+    }
+}
+
+MappedFile::~MappedFile() {
+    UnmapViewOfFile(mapping);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+}
+
+void MappedFile::sync(std::size_t offset, std::size_t count) {
+    FlushViewOfFile(mapping + offset, count);
+    FlushFileBuffers(fileHandle);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path, std::size_t minimumSize)
+    : fd(-1), mapping(nullptr), length(0)
+{
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("MappedFile: cannot open " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("MappedFile: cannot stat " + path);
+    }
+
+    length = static_cast<std::size_t>(info.st_size);
+    if (length < minimumSize) {
+        if (::ftruncate(fd, static_cast<off_t>(minimumSize)) != 0) {
+            ::close(fd);
+            throw std::runtime_error("MappedFile: cannot grow " + path);
+        }
+        length = minimumSize;
+    }
+
+    void* address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("MappedFile: cannot map " + path);
+    }
+    mapping = static_cast<unsigned char*>(address);
+}
+
+MappedFile::~MappedFile() {
+    ::munmap(mapping, length);
+    ::close(fd);
+}
+
+void MappedFile::sync(std::size_t offset, std::size_t count) {
+    // msync needs a page-aligned start address
+    std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::size_t alignedOffset = offset - offset % pageSize;
+    ::msync(mapping + alignedOffset, count + (offset - alignedOffset), MS_SYNC);
+}
+
+#endif
@@ -0,0 +1,157 @@
+#include "storage/StateSnapshot.h"
+#include "utils/Sha256.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    const char SNAPSHOT_MAGIC[8] = {'M', 'B', 'S', 'N', 'A', 'P', '0', '1'};
+    const std::size_t HEADER_SIZE = sizeof(SNAPSHOT_MAGIC) + 8 + Hash256::SIZE + 4 + 8;
+    const std::size_t ENTRY_SIZE = Hash256::SIZE + 8;
+
+    void putLE(std::vector<unsigned char>& out, std::uint64_t value, std::size_t width) {
+        for (std::size_t i = 0; i < width; ++i) {
+            out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+    std::uint64_t getLE(const unsigned char* in, std::size_t width) {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < width; ++i) {
+            value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    // Streams bytes to the file while folding them into the trailing checksum
+    struct ChecksummedWriter {
+        std::FILE* file;
+        Sha256 checksum;
+        std::vector<unsigned char> buffer;
+
+        void flush() {
+            checksum.update(buffer.data(), buffer.size());
+            if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+                throw std::runtime_error("StateSnapshotStore: write failed");
+            }
+            buffer.clear();
+        }
+    };
+}
+
+StateSnapshotStore::StateSnapshotStore(const std::string& directory, unsigned int keep)
+    : directory(directory), keep(keep == 0 ? 1 : keep) {}
+
+std::vector<std::pair<std::size_t, std::string>> StateSnapshotStore::list() const {
+    std::vector<std::pair<std::size_t, std::string>> files;
+    if (!std::filesystem::is_directory(directory)) return files;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        // state-<12 digits>.snap; leftover .tmp files from an interrupted write are ignored
+        std::string name = entry.path().filename().string();
+        if (name.size() != 23 || name.compare(0, 6, "state-") != 0 || name.compare(18, 5, ".snap") != 0) continue;
+        std::string digits = name.substr(6, 12);
+        if (!std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) continue;
+        files.emplace_back(static_cast<std::size_t>(std::stoull(digits)), entry.path().string());
+    }
+    std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    return files;
+}
+
+void StateSnapshotStore::write(const StateSnapshot& snapshot) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "state-%012llu.snap", static_cast<unsigned long long>(snapshot.blockCount));
+    std::string path = (std::filesystem::path(directory) / name).string();
+    std::string temporary = path + ".tmp";
+
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) throw std::runtime_error("StateSnapshotStore: cannot create " + temporary);
+
+    ChecksummedWriter writer{file, Sha256(), {}};
+    writer.buffer.reserve(64 * 1024);
+    try {
+        writer.buffer.insert(writer.buffer.end(), SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + sizeof(SNAPSHOT_MAGIC));
+        putLE(writer.buffer, snapshot.blockCount, 8);
+        writer.buffer.insert(writer.buffer.end(), snapshot.tipHash.bytes.begin(), snapshot.tipHash.bytes.end());
+        putLE(writer.buffer, static_cast<std::uint32_t>(snapshot.difficulty), 4);
+        putLE(writer.buffer, snapshot.balances.size(), 8);
+        snapshot.balances.forEach([&writer](const Hash256& address, Amount balance) {
+            writer.buffer.insert(writer.buffer.end(), address.bytes.begin(), address.bytes.end());
+            putLE(writer.buffer, static_cast<std::uint64_t>(balance), 8);
+            if (writer.buffer.size() >= 64 * 1024 - ENTRY_SIZE) writer.flush();
+        });
+        writer.flush();
+
+        Hash256 digest;
+        writer.checksum.finalize(digest);
+        if (std::fwrite(digest.data(), 1, Hash256::SIZE, file) != Hash256::SIZE) {
+            throw std::runtime_error("StateSnapshotStore: write failed");
+        }
+        std::fflush(file);
+#ifdef _WIN32
+        _commit(_fileno(file));
+#else
+        ::fsync(fileno(file));
+#endif
+    } catch (...) {
+        std::fclose(file);
+        std::remove(temporary.c_str());
+        throw;
+    }
+    std::fclose(file);
+    std::filesystem::rename(temporary, path);
+
+    // Keep the newest few so a snapshot ahead of a truncated block store has a fallback
+    std::vector<std::pair<std::size_t, std::string>> files = list();
+    for (std::size_t i = keep; i < files.size(); ++i) {
+        std::error_code ignored;
+        std::filesystem::remove(files[i].second, ignored);
+    }
+}
+
+bool StateSnapshotStore::loadLatest(const std::function<bool(std::size_t, const Hash256&)>& matchesChain,
+                                    StateSnapshot& snapshot) const {
+    for (const auto& file : list()) {
+        std::ifstream in(file.second, std::ios::binary);
+        std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (bytes.size() < HEADER_SIZE + Hash256::SIZE ||
+            std::memcmp(bytes.data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+            continue;
+        }
+
+        const std::size_t bodySize = bytes.size() - Hash256::SIZE;
+        Hash256 digest;
+        Sha256::hash(bytes.data(), bodySize, digest);
+        if (std::memcmp(digest.data(), bytes.data() + bodySize, Hash256::SIZE) != 0) continue;
+
+        const unsigned char* cursor = bytes.data() + sizeof(SNAPSHOT_MAGIC);
+        std::size_t blockCount = static_cast<std::size_t>(getLE(cursor, 8));
+        Hash256 tipHash;
+        std::memcpy(tipHash.data(), cursor + 8, Hash256::SIZE);
+        int difficulty = static_cast<int>(static_cast<std::int32_t>(getLE(cursor + 8 + Hash256::SIZE, 4)));
+        std::uint64_t entries = getLE(cursor + 12 + Hash256::SIZE, 8);
+        if (entries != (bodySize - HEADER_SIZE) / ENTRY_SIZE || (bodySize - HEADER_SIZE) % ENTRY_SIZE != 0) continue;
+        if (!matchesChain(blockCount, tipHash)) continue;
+
+        snapshot.blockCount = blockCount;
+        snapshot.tipHash = tipHash;
+        snapshot.difficulty = difficulty;
+        snapshot.balances = BalanceTable();
+        Hash256 address;
+        for (const unsigned char* entry = bytes.data() + HEADER_SIZE; entry < bytes.data() + bodySize; entry += ENTRY_SIZE) {
+            std::memcpy(address.data(), entry, Hash256::SIZE);
+            snapshot.balances.add(address, static_cast<Amount>(getLE(entry + Hash256::SIZE, 8)));
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,31 @@
+#include "utils/Amount.h"
+#include <cmath>
+#include <limits>
+
+Amount coinsToAmount(double coins) {
+    return static_cast<Amount>(std::llround(coins * static_cast<double>(COIN)));
+}
+
+std::string formatAmount(Amount amount) {
+    std::uint64_t magnitude = amount < 0 ? 0 - static_cast<std::uint64_t>(amount) : static_cast<std::uint64_t>(amount);
+    std::string text = amount < 0 ? "-" : "";
+    text += std::to_string(magnitude / COIN);
+
+    std::uint64_t fraction = magnitude % COIN;
+    if (fraction != 0) {
+        std::string digits = std::to_string(fraction);
+        digits.insert(0, 8 - digits.size(), '0');
+        digits.erase(digits.find_last_not_of('0') + 1);  // Trailing zeros add nothing
+        text += "." + digits;
+    }
+    return text;
+}
+
+bool checkedAdd(Amount a, Amount b, Amount& sum) {
+    if ((b > 0 && a > std::numeric_limits<Amount>::max() - b) ||
+        (b < 0 && a < std::numeric_limits<Amount>::min() - b)) {
+        return false;
+    }
+    sum = a + b;
+    return true;
+}
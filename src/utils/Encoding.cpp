@@ -0,0 +1,155 @@
+#include "utils/Encoding.h"
+#include <cstring>
+
+namespace {
+    const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    constexpr unsigned char INVALID = 0xff;
+
+    // Two output characters per byte, so hex encoding is one lookup and one copy per byte
+    struct HexTable {
+        char pairs[256][2];
+        unsigned char values[256];  // Digit value, or INVALID
+
+        constexpr HexTable() : pairs(), values() {
+            const char digits[] = "0123456789abcdef";
+            for (int i = 0; i < 256; ++i) {
+                pairs[i][0] = digits[i >> 4];
+                pairs[i][1] = digits[i & 0x0f];
+                values[i] = INVALID;
+            }
+            for (int i = 0; i < 10; ++i) values['0' + i] = static_cast<unsigned char>(i);
+            for (int i = 0; i < 6; ++i) {
+                values['a' + i] = static_cast<unsigned char>(10 + i);
+                values['A' + i] = static_cast<unsigned char>(10 + i);
+            }
+        }
+    };
+
+    struct Base64Table {
+        unsigned char values[256];  // Sextet value, or INVALID (including '=')
+
+        constexpr Base64Table() : values() {
+            for (int i = 0; i < 256; ++i) values[i] = INVALID;
+            for (int i = 0; i < 64; ++i) values[static_cast<unsigned char>(BASE64_ALPHABET[i])] = static_cast<unsigned char>(i);
+        }
+    };
+
+    constexpr HexTable HEX;
+    constexpr Base64Table BASE64;
+
+    // Earliest and latest instants with a four-digit year (0000-01-01, 9999-12-31T23:59:59)
+    constexpr std::int64_t MIN_UTC_SECONDS = -62167219200LL;
+    constexpr std::int64_t MAX_UTC_SECONDS = 253402300799LL;
+
+    char* putDigits(char* out, unsigned int value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        return out + width;
+    }
+}
+
+char* Encoding::toHex(const unsigned char* data, std::size_t size, char* out) {
+    for (std::size_t i = 0; i < size; ++i, out += 2) {
+        std::memcpy(out, HEX.pairs[data[i]], 2);
+    }
+    return out;
+}
+
+bool Encoding::fromHex(const char* hex, std::size_t length, unsigned char* out) {
+    if (length % 2 != 0) return false;
+    for (std::size_t i = 0; i < length; i += 2) {
+        unsigned char hi = HEX.values[static_cast<unsigned char>(hex[i])];
+        unsigned char lo = HEX.values[static_cast<unsigned char>(hex[i + 1])];
+        if ((hi | lo) == INVALID) return false;
+        *out++ = static_cast<unsigned char>((hi << 4) | lo);
+    }
+    return true;
+}
+
+char* Encoding::toBase64(const unsigned char* data, std::size_t size, char* out) {
+    std::size_t i = 0;
+    for (; i + 3 <= size; i += 3, out += 4) {
+        std::uint32_t group = (std::uint32_t(data[i]) << 16) | (std::uint32_t(data[i + 1]) << 8) | data[i + 2];
+        out[0] = BASE64_ALPHABET[group >> 18];
+        out[1] = BASE64_ALPHABET[(group >> 12) & 0x3f];
+        out[2] = BASE64_ALPHABET[(group >> 6) & 0x3f];
+        out[3] = BASE64_ALPHABET[group & 0x3f];
+    }
+    if (i < size) {
+        std::uint32_t group = std::uint32_t(data[i]) << 16;
+        if (i + 1 < size) group |= std::uint32_t(data[i + 1]) << 8;
+        out[0] = BASE64_ALPHABET[group >> 18];
+        out[1] = BASE64_ALPHABET[(group >> 12) & 0x3f];
+        out[2] = i + 1 < size ? BASE64_ALPHABET[(group >> 6) & 0x3f] : '=';
+        out[3] = '=';
+        out += 4;
+    }
+    return out;
+}
+
+bool Encoding::fromBase64(const char* text, std::size_t length, unsigned char* out, std::size_t& written) {
+    if (length % 4 != 0) return false;
+    std::size_t padding = 0;
+    if (length > 0 && text[length - 1] == '=') ++padding;
+    if (padding == 1 && text[length - 2] == '=') ++padding;
+
+    unsigned char* start = out;
+    for (std::size_t i = 0; i < length; i += 4) {
+        bool last = i + 4 == length;
+        unsigned char a = BASE64.values[static_cast<unsigned char>(text[i])];
+        unsigned char b = BASE64.values[static_cast<unsigned char>(text[i + 1])];
+        unsigned char c = last && padding >= 2 ? 0 : BASE64.values[static_cast<unsigned char>(text[i + 2])];
+        unsigned char d = last && padding >= 1 ? 0 : BASE64.values[static_cast<unsigned char>(text[i + 3])];
+        if ((a | b | c | d) == INVALID) return false;
+        // The bits padding leaves unused must be zero, or several inputs would decode alike
+        if (last && padding == 2 && (b & 0x0f) != 0) return false;
+        if (last && padding == 1 && (c & 0x03) != 0) return false;
+
+        std::uint32_t group = (std::uint32_t(a) << 18) | (std::uint32_t(b) << 12) | (std::uint32_t(c) << 6) | d;
+        *out++ = static_cast<unsigned char>(group >> 16);
+        if (!last || padding < 2) *out++ = static_cast<unsigned char>(group >> 8);
+        if (!last || padding < 1) *out++ = static_cast<unsigned char>(group);
+    }
+    written = static_cast<std::size_t>(out - start);
+    return true;
+}
+
+char* Encoding::formatUtcTime(std::int64_t epochSeconds, char* out) {
+    // Clamped to the years the fixed-width format can show
+    if (epochSeconds < MIN_UTC_SECONDS) epochSeconds = MIN_UTC_SECONDS;
+    if (epochSeconds > MAX_UTC_SECONDS) epochSeconds = MAX_UTC_SECONDS;
+
+    std::int64_t days = epochSeconds / 86400;
+    std::int64_t seconds = epochSeconds % 86400;
+    if (seconds < 0) {
+        seconds += 86400;
+        --days;
+    }
+
+    // Civil date from days since 1970-01-01 (proleptic Gregorian, 400-year eras)
+    days += 719468;
+    std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    std::int64_t dayOfEra = days - era * 146097;
+    std::int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    std::int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    std::int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;  // March = 0
+    unsigned int day = static_cast<unsigned int>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+    unsigned int month = static_cast<unsigned int>(shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+    unsigned int year = static_cast<unsigned int>(yearOfEra + era * 400 + (month <= 2 ? 1 : 0));
+
+    out = putDigits(out, year, 4);
+    *out++ = '-';
+    out = putDigits(out, month, 2);
+    *out++ = '-';
+    out = putDigits(out, day, 2);
+    *out++ = 'T';
+    out = putDigits(out, static_cast<unsigned int>(seconds / 3600), 2);
+    *out++ = ':';
+    out = putDigits(out, static_cast<unsigned int>(seconds / 60 % 60), 2);
+    *out++ = ':';
+    out = putDigits(out, static_cast<unsigned int>(seconds % 60), 2);
+    *out++ = 'Z';
+    return out;
+}
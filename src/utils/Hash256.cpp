@@ -0,0 +1,41 @@
+#include "utils/Hash256.h"
+#include "utils/Encoding.h"
+
+bool Hash256::isZero() const {
+    for (unsigned char b : bytes) {
+        if (b != 0) return false;
+    }
+    return true;
+}
+
+int Hash256::leadingZeroBits() const {
+    int bits = 0;
+    for (unsigned char b : bytes) {
+        if (b == 0) {
+            bits += 8;
+            continue;
+        }
+        for (unsigned char mask = 0x80; (b & mask) == 0; mask >>= 1) {
+            ++bits;
+        }
+        break;
+    }
+    return bits;
+}
+
+std::string Hash256::toHex() const {
+    std::string hex(SIZE * 2, '0');
+    Encoding::toHex(bytes.data(), SIZE, &hex[0]);
+    return hex;
+}
+
+char* Hash256::toHex(char* out) const {
+    return Encoding::toHex(bytes.data(), SIZE, out);
+}
+
+bool Hash256::fromHex(const std::string& hex, Hash256& out) {
+    Hash256 parsed;
+    if (hex.size() != SIZE * 2 || !Encoding::fromHex(hex.data(), hex.size(), parsed.bytes.data())) return false;
+    out = parsed;
+    return true;
+}
@@ -1,19 +1,33 @@
 #include "utils/Hashing.h"
-#include <openssl/sha.h>
-#include <sstream>
-#include <iomanip>
+#include "utils/Sha256.h"
 
-std::string Hashing::sha256(const std::string& input) {
-    unsigned char hash[SHA256_DIGEST_LENGTH];
-    SHA256_CTX sha256;
-    
-    SHA256_Init(&sha256);
-    SHA256_Update(&sha256, input.c_str(), input.length());
-    SHA256_Final(hash, &sha256);
+Hash256 Hashing::sha256(const std::string& input) {
+    return sha256(input.data(), input.length());
+}
+
+Hash256 Hashing::sha256(const void* data, std::size_t length) {
+    Hash256 hash;
+    Sha256::hash(data, length, hash);
+    return hash;
+}
+
+std::vector<Hash256> Hashing::sha256Batch(const std::vector<std::string>& inputs) {
+    std::vector<const void*> data(inputs.size());
+    std::vector<std::size_t> lengths(inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        data[i] = inputs[i].data();
+        lengths[i] = inputs[i].length();
+    }
 
-    std::stringstream ss;
-    for (int i = 0; i < SHA256_DIGEST_LENGTH; ++i)
-        ss << std::hex << std::setw(2) << std::setfill('0') << (int)hash[i];
+    std::vector<Hash256> hashes(inputs.size());
+    sha256Batch(data.data(), lengths.data(), inputs.size(), hashes.data());
+    return hashes;
+}
+
+void Hashing::sha256Batch(const void* const* data, const std::size_t* lengths, std::size_t count, Hash256* out) {
+    Sha256::hashBatch(data, lengths, count, out);
+}
 
-    return ss.str();
+std::string Hashing::sha256Hex(const std::string& input) {
+    return sha256(input).toHex();
 }
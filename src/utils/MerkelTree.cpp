@@ -1,27 +1,166 @@
 #include "utils/MerkleTree.h"
 #include "utils/Hashing.h"
+#include <cstring>
+#include <stdexcept>
 
-std::string MerkleTree::computeMerkleRoot(const std::vector<std::string>& txHashes) {
-    if (txHashes.empty()) return "";
+namespace {
+    Hash256 hashPair(const Hash256& left, const Hash256& right) {
+        unsigned char combined[2 * Hash256::SIZE];
+        std::memcpy(combined, left.data(), Hash256::SIZE);
+        std::memcpy(combined + Hash256::SIZE, right.data(), Hash256::SIZE);
+        return Hashing::sha256(combined, sizeof(combined));
+    }
+}
+
+MerkleTree::MerkleTree(std::pmr::memory_resource* resource)
+    : nodes(resource), levelOffsets(resource), leafCapacity(0), leafCount(0) {
+}
 
-    std::vector<std::string> currentLevel = txHashes;
+MerkleTree::MerkleTree(const std::vector<Hash256>& leaves) : MerkleTree(leaves.data(), leaves.size()) {
+}
 
-    while (currentLevel.size() > 1) {
-        std::vector<std::string> nextLevel;
+MerkleTree::MerkleTree(const Hash256* leaves, std::size_t count, std::pmr::memory_resource* resource)
+    : MerkleTree(resource) {
+    if (count == 0) return;
 
-        for (size_t i = 0; i < currentLevel.size(); i += 2) {
-            std::string left = currentLevel[i]; // Take left child's hash
+    std::size_t capacity = 1;
+    while (capacity < count) capacity <<= 1;
+    reserveLeaves(capacity);
 
-            // If there's no right child, duplicate the left child's hash
-            std::string right = (i + 1 < currentLevel.size()) ? currentLevel[i + 1] : left;
+    leafCount = count;
+    std::copy(leaves, leaves + count, nodes.begin());
 
-            std::string combined = left + right;
-            std::string hashed = Hashing::sha256(combined); // Hash the concatenated string
-            nextLevel.push_back(hashed);
+    std::pmr::vector<unsigned char> combined(resource);
+    std::pmr::vector<const void*> pairs(resource);
+    std::pmr::vector<std::size_t> lengths(resource);
+
+    for (std::size_t level = 0; levelSize(level) > 1; ++level) {
+        const Hash256* current = nodes.data() + levelOffsets[level];
+        std::size_t width = levelSize(level);
+        std::size_t pairCount = (width + 1) / 2;
+        combined.resize(pairCount * 2 * Hash256::SIZE);
+        pairs.resize(pairCount);
+        lengths.assign(pairCount, 2 * Hash256::SIZE);
+
+        for (std::size_t i = 0; i < width; i += 2) {
+            // If there's no right child, duplicate the left child's hash
+            const Hash256& right = (i + 1 < width) ? current[i + 1] : current[i];
+            unsigned char* pair = combined.data() + i * Hash256::SIZE;
+            std::memcpy(pair, current[i].data(), Hash256::SIZE);
+            std::memcpy(pair + Hash256::SIZE, right.data(), Hash256::SIZE);
+            pairs[i / 2] = pair;
         }
 
-        currentLevel = nextLevel;
+        // Hash every concatenated pair of the level in one batch
+        Hashing::sha256Batch(pairs.data(), lengths.data(), pairCount, nodes.data() + levelOffsets[level + 1]);
+    }
+}
+
+std::size_t MerkleTree::levelSize(std::size_t level) const {
+    return (leafCount + (std::size_t(1) << level) - 1) >> level;
+}
+
+void MerkleTree::reserveLeaves(std::size_t capacity) {
+    std::pmr::memory_resource* resource = nodes.get_allocator().resource();
+    std::pmr::vector<std::size_t> offsets(resource);
+    std::size_t total = 0;
+    for (std::size_t width = capacity; ; width >>= 1) {
+        offsets.push_back(total);
+        total += width;
+        if (width == 1) break;
+    }
+
+    // Move existing levels into the wider layout; amortized O(1) per append
+    std::pmr::vector<Hash256> resized(total, resource);
+    for (std::size_t level = 0; level < levelOffsets.size(); ++level) {
+        std::size_t count = levelSize(level);
+        std::copy(nodes.begin() + levelOffsets[level], nodes.begin() + levelOffsets[level] + count,
+                  resized.begin() + offsets[level]);
+    }
+
+    nodes.swap(resized);
+    levelOffsets.swap(offsets);
+    leafCapacity = capacity;
+}
+
+void MerkleTree::updatePath(std::size_t leafIndex) {
+    std::size_t index = leafIndex;
+    for (std::size_t level = 0; levelSize(level) > 1; ++level) {
+        const Hash256* current = nodes.data() + levelOffsets[level];
+        std::size_t left = index & ~std::size_t(1);
+        const Hash256& right = (left + 1 < levelSize(level)) ? current[left + 1] : current[left];
+        index >>= 1;
+        nodes[levelOffsets[level + 1] + index] = hashPair(current[left], right);
+    }
+}
+
+void MerkleTree::append(const Hash256& leaf) {
+    if (leafCount == leafCapacity) {
+        reserveLeaves(leafCapacity == 0 ? 1 : leafCapacity * 2);
+    }
+    nodes[leafCount] = leaf;
+    ++leafCount;
+    updatePath(leafCount - 1);
+}
+
+void MerkleTree::replace(std::size_t index, const Hash256& leaf) {
+    if (index >= leafCount) {
+        throw std::out_of_range("MerkleTree::replace: leaf index out of range");
+    }
+    nodes[index] = leaf;
+    updatePath(index);
+}
+
+std::size_t MerkleTree::size() const {
+    return leafCount;
+}
+
+Hash256 MerkleTree::getRoot() const {
+    if (leafCount == 0) return Hash256{};
+
+    std::size_t level = 0;
+    while (levelSize(level) > 1) ++level;
+    return nodes[levelOffsets[level]];
+}
+
+MerkleProof MerkleTree::getProof(std::size_t index) const {
+    if (index >= leafCount) {
+        throw std::out_of_range("MerkleTree::getProof: leaf index out of range");
+    }
+
+    MerkleProof proof;
+    proof.leafIndex = index;
+    proof.leafCount = leafCount;
+    for (std::size_t level = 0; levelSize(level) > 1; ++level) {
+        const Hash256* current = nodes.data() + levelOffsets[level];
+        std::size_t sibling = index ^ 1;
+        proof.siblings.push_back(sibling < levelSize(level) ? current[sibling] : current[index]);
+        index >>= 1;
     }
+    return proof;
+}
+
+bool MerkleTree::verifyProof(const Hash256& leaf, const MerkleProof& proof, const Hash256& root) {
+    if (proof.leafIndex >= proof.leafCount) return false;
+
+    // The path length is fixed by the leaf count; reject truncated or padded proofs
+    std::size_t depth = 0;
+    while ((std::size_t(1) << depth) < proof.leafCount) ++depth;
+    if (proof.siblings.size() != depth) return false;
+
+    Hash256 current = leaf;
+    std::size_t index = proof.leafIndex;
+    for (const Hash256& sibling : proof.siblings) {
+        current = (index & 1) ? hashPair(sibling, current) : hashPair(current, sibling);
+        index >>= 1;
+    }
+    return current == root;
+}
+
+Hash256 MerkleTree::computeMerkleRoot(const std::vector<Hash256>& txHashes) {
+    return MerkleTree(txHashes).getRoot();
+}
 
-    return currentLevel.front(); // Merkle root
+Hash256 MerkleTree::computeMerkleRoot(const Hash256* txHashes, std::size_t count, std::pmr::memory_resource* resource) {
+    return MerkleTree(txHashes, count, resource).getRoot();
 }
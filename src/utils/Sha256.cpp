@@ -0,0 +1,306 @@
+#include "utils/Sha256.h"
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SHA256_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+    const std::uint32_t K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    const std::uint32_t INITIAL_STATE[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    inline std::uint32_t rotr(std::uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    inline std::uint32_t loadBE32(const unsigned char* p) {
+        return (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) | (std::uint32_t(p[2]) << 8) | std::uint32_t(p[3]);
+    }
+
+    inline void storeBE32(unsigned char* p, std::uint32_t v) {
+        p[0] = static_cast<unsigned char>(v >> 24);
+        p[1] = static_cast<unsigned char>(v >> 16);
+        p[2] = static_cast<unsigned char>(v >> 8);
+        p[3] = static_cast<unsigned char>(v);
+    }
+
+    // Writes the final padded block(s) for a message tail; returns the number of blocks (1 or 2)
+    std::size_t padTail(unsigned char out[128], const unsigned char* tail, std::size_t tailLength, std::uint64_t totalLength) {
+        std::size_t blocks = tailLength + 9 <= 64 ? 1 : 2;
+        std::memset(out, 0, blocks * 64);
+        std::memcpy(out, tail, tailLength);
+        out[tailLength] = 0x80;
+        std::uint64_t bits = totalLength * 8;
+        for (int i = 0; i < 8; ++i) {
+            out[blocks * 64 - 1 - i] = static_cast<unsigned char>(bits >> (8 * i));
+        }
+        return blocks;
+    }
+
+    void writeDigest(const std::uint32_t state[8], Hash256& digest) {
+        for (int i = 0; i < 8; ++i) {
+            storeBE32(digest.data() + 4 * i, state[i]);
+        }
+    }
+
+    struct CpuFeatures {
+        bool avx2 = false;
+        bool shaNi = false;
+    };
+
+    CpuFeatures detectCpuFeatures() {
+        CpuFeatures features;
+#ifdef SHA256_X86
+        unsigned int leaf1[4] = {0, 0, 0, 0};
+        unsigned int leaf7[4] = {0, 0, 0, 0};
+#if defined(_MSC_VER)
+        int regs[4];
+        __cpuid(regs, 0);
+        unsigned int maxLeaf = static_cast<unsigned int>(regs[0]);
+        __cpuid(regs, 1);
+        for (int i = 0; i < 4; ++i) leaf1[i] = static_cast<unsigned int>(regs[i]);
+        if (maxLeaf >= 7) {
+            __cpuidex(regs, 7, 0);
+            for (int i = 0; i < 4; ++i) leaf7[i] = static_cast<unsigned int>(regs[i]);
+        }
+#else
+        unsigned int maxLeaf = __get_cpuid_max(0, nullptr);
+        __get_cpuid(1, &leaf1[0], &leaf1[1], &leaf1[2], &leaf1[3]);
+        if (maxLeaf >= 7) {
+            __cpuid_count(7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3]);
+        }
+#endif
+        bool ssse3 = (leaf1[2] >> 9) & 1;
+        bool sse41 = (leaf1[2] >> 19) & 1;
+        bool osxsave = (leaf1[2] >> 27) & 1;
+        bool avx = (leaf1[2] >> 28) & 1;
+
+        bool ymmEnabled = false;
+        if (osxsave && avx) {
+#if defined(_MSC_VER)
+            unsigned long long xcr0 = _xgetbv(0);
+#else
+            unsigned int eax, edx;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            unsigned long long xcr0 = (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+            ymmEnabled = (xcr0 & 0x6) == 0x6;
+        }
+
+        features.avx2 = ymmEnabled && ((leaf7[1] >> 5) & 1);
+        features.shaNi = ssse3 && sse41 && ((leaf7[1] >> 29) & 1);
+#endif
+        return features;
+    }
+
+    const CpuFeatures& cpuFeatures() {
+        static const CpuFeatures features = detectCpuFeatures();
+        return features;
+    }
+
+    Sha256::Backend bestBackend() {
+        if (cpuFeatures().shaNi) return Sha256::Backend::ShaNi;
+        if (cpuFeatures().avx2) return Sha256::Backend::Avx2;
+        return Sha256::Backend::Scalar;
+    }
+
+    std::atomic<Sha256::Backend>& selectedBackend() {
+        static std::atomic<Sha256::Backend> backend{bestBackend()};
+        return backend;
+    }
+}
+
+void Sha256::compressScalar(std::uint32_t state[8], const unsigned char* blocks, std::size_t count) {
+    std::uint32_t w[64];
+    for (; count > 0; --count, blocks += 64) {
+        for (int i = 0; i < 16; ++i) {
+            w[i] = loadBE32(blocks + 4 * i);
+        }
+        for (int i = 16; i < 64; ++i) {
+            std::uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            std::uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            std::uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            std::uint32_t ch = (e & f) ^ (~e & g);
+            std::uint32_t t1 = h + s1 + ch + K[i] + w[i];
+            std::uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            std::uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            std::uint32_t t2 = s0 + maj;
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+Sha256::Sha256() : totalLength(0), bufferLength(0) {
+    std::memcpy(state, INITIAL_STATE, sizeof(state));
+}
+
+void Sha256::update(const void* data, std::size_t length) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    // Single stream: SHA-NI when selected, otherwise scalar (AVX2 only pays off across lanes)
+    auto compress = activeBackend() == Backend::ShaNi ? &compressShaNi : &compressScalar;
+    totalLength += length;
+
+    if (bufferLength > 0) {
+        std::size_t take = 64 - bufferLength < length ? 64 - bufferLength : length;
+        std::memcpy(buffer + bufferLength, bytes, take);
+        bufferLength += take;
+        bytes += take;
+        length -= take;
+        if (bufferLength < 64) return;
+        compress(state, buffer, 1);
+        bufferLength = 0;
+    }
+
+    if (length >= 64) {
+        compress(state, bytes, length / 64);
+        bytes += length - length % 64;
+        length %= 64;
+    }
+
+    std::memcpy(buffer, bytes, length);
+    bufferLength = length;
+}
+
+void Sha256::finalize(Hash256& digest) {
+    unsigned char padded[128];
+    std::size_t blocks = padTail(padded, buffer, bufferLength, totalLength);
+    auto compress = activeBackend() == Backend::ShaNi ? &compressShaNi : &compressScalar;
+    compress(state, padded, blocks);
+    writeDigest(state, digest);
+}
+
+void Sha256::padFinalBlock(const void* tail, std::size_t tailLength, unsigned char block[64]) const {
+    unsigned char padded[128];
+    padTail(padded, static_cast<const unsigned char*>(tail), tailLength, totalLength + tailLength);
+    std::memcpy(block, padded, 64);
+}
+
+void Sha256::finalizeBlock(const unsigned char block[64], Hash256& digest) const {
+    std::uint32_t words[8];
+    std::memcpy(words, state, sizeof(words));
+    if (activeBackend() == Backend::ShaNi) {
+        compressShaNi(words, block, 1);
+    } else {
+        compressScalar(words, block, 1);
+    }
+    writeDigest(words, digest);
+}
+
+void Sha256::hash(const void* data, std::size_t length, Hash256& digest) {
+    Sha256 ctx;
+    ctx.update(data, length);
+    ctx.finalize(digest);
+}
+
+void Sha256::hashBatch(const void* const* data, const std::size_t* lengths, std::size_t count, Hash256* out) {
+    if (activeBackend() != Backend::Avx2) {
+        for (std::size_t i = 0; i < count; ++i) {
+            hash(data[i], lengths[i], out[i]);
+        }
+        return;
+    }
+
+    // Multi-buffer: eight messages advance one block at a time in parallel lanes.
+    // A lane whose message has run out of blocks is masked and keeps its final state.
+    static const unsigned char zeroBlock[64] = {};
+    for (std::size_t base = 0; base < count; base += 8) {
+        std::size_t lanes = count - base < 8 ? count - base : 8;
+
+        std::uint32_t states[8][8];
+        unsigned char tails[8][128];
+        std::size_t fullBlocks[8] = {};
+        std::size_t totalBlocks[8] = {};
+        std::size_t maxBlocks = 0;
+
+        for (std::size_t lane = 0; lane < 8; ++lane) {
+            for (int word = 0; word < 8; ++word) {
+                states[word][lane] = INITIAL_STATE[word];
+            }
+            if (lane >= lanes) continue;
+            const unsigned char* message = static_cast<const unsigned char*>(data[base + lane]);
+            std::size_t length = lengths[base + lane];
+            fullBlocks[lane] = length / 64;
+            totalBlocks[lane] = fullBlocks[lane] + padTail(tails[lane], message + length - length % 64, length % 64, length);
+            if (totalBlocks[lane] > maxBlocks) maxBlocks = totalBlocks[lane];
+        }
+
+        for (std::size_t block = 0; block < maxBlocks; ++block) {
+            const unsigned char* blockPtrs[8];
+            unsigned int activeMask = 0;
+            for (std::size_t lane = 0; lane < 8; ++lane) {
+                if (lane >= lanes || block >= totalBlocks[lane]) {
+                    blockPtrs[lane] = zeroBlock;
+                } else if (block < fullBlocks[lane]) {
+                    blockPtrs[lane] = static_cast<const unsigned char*>(data[base + lane]) + block * 64;
+                    activeMask |= 1u << lane;
+                } else {
+                    blockPtrs[lane] = tails[lane] + (block - fullBlocks[lane]) * 64;
+                    activeMask |= 1u << lane;
+                }
+            }
+            compress8Avx2(states, blockPtrs, activeMask);
+        }
+
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            std::uint32_t laneState[8];
+            for (int word = 0; word < 8; ++word) {
+                laneState[word] = states[word][lane];
+            }
+            writeDigest(laneState, out[base + lane]);
+        }
+    }
+}
+
+bool Sha256::isSupported(Backend backend) {
+    switch (backend) {
+        case Backend::Scalar: return true;
+        case Backend::Avx2: return cpuFeatures().avx2;
+        case Backend::ShaNi: return cpuFeatures().shaNi;
+    }
+    return false;
+}
+
+Sha256::Backend Sha256::activeBackend() {
+    return selectedBackend().load(std::memory_order_relaxed);
+}
+
+bool Sha256::setBackend(Backend backend) {
+    if (!isSupported(backend)) return false;
+    selectedBackend().store(backend, std::memory_order_relaxed);
+    return true;
+}
+
+const char* Sha256::backendName(Backend backend) {
+    switch (backend) {
+        case Backend::Scalar: return "scalar";
+        case Backend::Avx2: return "avx2";
+        case Backend::ShaNi: return "sha-ni";
+    }
+    return "unknown";
+}
@@ -0,0 +1,155 @@
+// SIMD SHA-256 kernels. They are compiled with per-function target attributes
+// and only called after Sha256 has confirmed CPU support at runtime.
+#include "utils/Sha256.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SHA256_TARGET(features) __attribute__((target(features)))
+#else
+#define SHA256_TARGET(features)
+#endif
+
+namespace {
+    alignas(16) const std::uint32_t K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    SHA256_TARGET("avx2") inline __m256i rotr8(__m256i x, int n) {
+        return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+    }
+
+    SHA256_TARGET("avx2") inline __m256i add8(__m256i a, __m256i b) {
+        return _mm256_add_epi32(a, b);
+    }
+}
+
+SHA256_TARGET("sha,sse4.1,ssse3")
+void Sha256::compressShaNi(std::uint32_t state[8], const unsigned char* blocks, std::size_t count) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // Rearrange the state into the ABEF/CDGH register layout the SHA instructions expect
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (; count > 0; --count, blocks += 64) {
+        const __m128i abefSave = state0;
+        const __m128i cdghSave = state1;
+        __m128i msgs[4];
+
+        for (int i = 0; i < 4; ++i) {
+            msgs[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16 * i)), byteSwap);
+        }
+
+        // Sixteen groups of four rounds; msg1/msg2 extend the schedule four words at a time.
+        // Fully unrolled so the four message registers never spill.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC unroll 16
+#elif defined(__clang__)
+#pragma unroll
+#endif
+        for (int i = 0; i < 16; ++i) {
+            __m128i& current = msgs[i & 3];
+            __m128i msg = _mm_add_epi32(current, _mm_load_si128(reinterpret_cast<const __m128i*>(&K[4 * i])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            if (i >= 3 && i <= 14) {
+                __m128i& next = msgs[(i + 1) & 3];
+                next = _mm_add_epi32(next, _mm_alignr_epi8(current, msgs[(i + 3) & 3], 4));
+                next = _mm_sha256msg2_epu32(next, current);
+            }
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+            if (i >= 1 && i <= 12) {
+                __m128i& previous = msgs[(i + 3) & 3];
+                previous = _mm_sha256msg1_epu32(previous, current);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+SHA256_TARGET("avx2")
+void Sha256::compress8Avx2(std::uint32_t states[8][8], const unsigned char* const blocks[8], unsigned int activeMask) {
+    // Transpose: w[i] holds message word i of every lane
+    __m256i w[64];
+    for (int i = 0; i < 16; ++i) {
+        alignas(32) std::uint32_t words[8];
+        for (int lane = 0; lane < 8; ++lane) {
+            const unsigned char* p = blocks[lane] + 4 * i;
+            words[lane] = (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) | (std::uint32_t(p[2]) << 8) | std::uint32_t(p[3]);
+        }
+        w[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(words));
+    }
+    for (int i = 16; i < 64; ++i) {
+        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(w[i - 15], 7), rotr8(w[i - 15], 18)), _mm256_srli_epi32(w[i - 15], 3));
+        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(w[i - 2], 17), rotr8(w[i - 2], 19)), _mm256_srli_epi32(w[i - 2], 10));
+        w[i] = add8(add8(w[i - 16], s0), add8(w[i - 7], s1));
+    }
+
+    __m256i v[8];
+    for (int j = 0; j < 8; ++j) {
+        v[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states[j]));
+    }
+    __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+
+    for (int i = 0; i < 64; ++i) {
+        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8(e, 6), rotr8(e, 11)), rotr8(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = add8(add8(add8(h, s1), add8(ch, _mm256_set1_epi32(static_cast<int>(K[i])))), w[i]);
+        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8(a, 2), rotr8(a, 13)), rotr8(a, 22));
+        __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        __m256i t2 = add8(s0, maj);
+        h = g; g = f; f = e; e = add8(d, t1);
+        d = c; c = b; b = a; a = add8(t1, t2);
+    }
+
+    // Only lanes still consuming message blocks take the updated state
+    const __m256i laneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(activeMask)), laneBits), laneBits);
+    const __m256i result[8] = {a, b, c, d, e, f, g, h};
+    for (int j = 0; j < 8; ++j) {
+        __m256i updated = add8(v[j], result[j]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(states[j]), _mm256_blendv_epi8(v[j], updated, mask));
+    }
+}
+
+#else
+
+// Non-x86 builds never select the SIMD backends; keep the symbols for the linker
+void Sha256::compressShaNi(std::uint32_t state[8], const unsigned char* blocks, std::size_t count) {
+    compressScalar(state, blocks, count);
+}
+
+void Sha256::compress8Avx2(std::uint32_t states[8][8], const unsigned char* const blocks[8], unsigned int activeMask) {
+    for (int lane = 0; lane < 8; ++lane) {
+        if (!(activeMask & (1u << lane))) continue;
+        std::uint32_t laneState[8];
+        for (int j = 0; j < 8; ++j) laneState[j] = states[j][lane];
+        compressScalar(laneState, blocks[lane], 1);
+        for (int j = 0; j < 8; ++j) states[j][lane] = laneState[j];
+    }
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include "utils/ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned int threadCount) : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+unsigned int ThreadPool::size() const {
+    return static_cast<unsigned int>(workers.size());
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body) {
+    if (count == 0) return;
+
+    std::size_t chunks = workers.size() < count ? workers.size() : count;
+    std::size_t chunkSize = (count + chunks - 1) / chunks;
+
+    std::vector<std::future<void>> pending;
+    pending.reserve(chunks);
+    for (std::size_t begin = 0; begin < count; begin += chunkSize) {
+        std::size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        pending.push_back(submit([&body, begin, end]() {
+            for (std::size_t i = begin; i < end; ++i) {
+                body(i);
+            }
+        }));
+    }
+
+    // get() rethrows a worker's exception; wait for every chunk before leaving
+    // so no task still references body
+    std::exception_ptr failure;
+    for (auto& future : pending) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!failure) failure = std::current_exception();
+        }
+    }
+    if (failure) std::rethrow_exception(failure);
+}
@@ -1,19 +1,18 @@
 #include "utils/Timestamp.h"
+#include "utils/Encoding.h"
 #include <chrono>
-#include <ctime>
-#include <sstream>
-#include <iomanip>
 
-std::string Timestamp::getCurrentUTCTime() {
-    auto now = std::chrono::system_clock::now(); // Captures the current time of system clock
-
-    // Convert to time_t for easier formatting
-    std::time_t now_time = std::chrono::system_clock::to_time_t(now);
+char* Timestamp::getCurrentUTCTime(char* out) {
+    // Formatted by hand: std::gmtime shares one static buffer between threads
+    return Encoding::formatUtcTime(getCurrentEpochSeconds(), out);
+}
 
-    // gmtime converts time_t to UTC time
-    std::tm* gmt_time = std::gmtime(&now_time);
+std::string Timestamp::getCurrentUTCTime() {
+    char buffer[Encoding::UTC_TIME_SIZE];
+    return std::string(buffer, getCurrentUTCTime(buffer));
+}
 
-    std::ostringstream oss;
-    oss << std::put_time(gmt_time, "%Y-%m-%dT%H:%M:%SZ");
-    return oss.str();
+long long Timestamp::getCurrentEpochSeconds() {
+    auto now = std::chrono::system_clock::now();
+    return std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
 }